@@ -0,0 +1,225 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: Display.c
+* Description: File containing the multiplexed display functions
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#include "Display.h"
+
+#define DISPLAY_ROW_MASK         ((uint8_t)((1U<<DISPLAY_ROWS)-1U))
+#define DISPLAY_FULL             255
+#define DISPLAY_FONT_SIZE        18
+
+//port values with the polarity applied
+#if DISPLAY_SEG_ACTIVE_LOW
+#define DISPLAY_SEG_VALUE(u8Segs)   ((uint8_t)~(u8Segs))
+#else
+#define DISPLAY_SEG_VALUE(u8Segs)   (u8Segs)
+#endif
+#if DISPLAY_ROW_ACTIVE_LOW
+#define DISPLAY_ROWS_OFF()          (DISPLAY_ROW_PORT_R|=DISPLAY_ROW_MASK)
+#define DISPLAY_ROW_ON(u8Row)       (DISPLAY_ROW_PORT_R&=(uint8_t)~(1<<(u8Row)))
+#else
+#define DISPLAY_ROWS_OFF()          (DISPLAY_ROW_PORT_R&=(uint8_t)~DISPLAY_ROW_MASK)
+#define DISPLAY_ROW_ON(u8Row)       (DISPLAY_ROW_PORT_R|=(uint8_t)(1<<(u8Row)))
+#endif
+
+//segments a-g in bits 0-6: 0-9, A-F, blank, minus
+static const __flash uint8_t Gau8_DisplayFont[DISPLAY_FONT_SIZE] =
+{
+   0x3F,0x06,0x5B,0x4F,0x66,0x6D,0x7D,0x07,0x7F,0x6F,0x77,0x7C,0x39,0x5E,0x79,0x71,0x00,0x40
+};
+
+uint8_t  Gau8_DisplayFrames[2][DISPLAY_ROWS];
+volatile uint8_t Gu8_DisplayFront=0;            //frame the refresh shows
+volatile uint8_t Gu8_DisplaySwap=0;             //1 until the refresh takes the back frame
+uint8_t  Gu8_DisplayRow=0;
+uint8_t  Gau8_DisplayLevel[DISPLAY_ROWS];
+uint16_t Gau16_DisplayOnUs[DISPLAY_ROWS];       //on time of each row, from its level
+strSTimer_t Gstr_DisplayRowTimer;
+strSTimer_t Gstr_DisplayBlankTimer;
+
+
+/******************** Private Functions ****************************************/
+
+//end of a dimmed row's on time
+static void Display_Blank(void* pvCtx)
+{
+   (void)pvCtx;
+   DISPLAY_ROWS_OFF();
+}
+
+//row slot: light the next row of the front frame
+static void Display_Refresh(void* pvCtx)
+{
+   uint8_t u8Row;
+   (void)pvCtx;
+
+   u8Row=Gu8_DisplayRow+1;
+   if (u8Row >= DISPLAY_ROWS)
+   {
+      u8Row=0;
+      //a new frame, take the back buffer if it was handed over
+      if (Gu8_DisplaySwap)
+      {
+         Gu8_DisplayFront^=1;
+         Gu8_DisplaySwap=0;
+      }
+   }
+   Gu8_DisplayRow=u8Row;
+   STimer_Stop(&Gstr_DisplayBlankTimer);
+   //rows off before the segments change so the last row does not ghost into the next
+   DISPLAY_ROWS_OFF();
+   if (Gau8_DisplayLevel[u8Row] == 0)
+   {
+      return;
+   }
+   DISPLAY_SEG_PORT_R=DISPLAY_SEG_VALUE(Gau8_DisplayFrames[Gu8_DisplayFront][u8Row]);
+   DISPLAY_ROW_ON(u8Row);
+   if (Gau8_DisplayLevel[u8Row] != DISPLAY_FULL &&
+       STimer_Create(&Gstr_DisplayBlankTimer,Gau16_DisplayOnUs[u8Row],0,Display_Blank,NULLPTR) == SUCCESS)
+   {
+      STimer_Restart(&Gstr_DisplayBlankTimer);
+   }
+}
+
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set up the ports and start the refresh with blank frames at full brightness
+************************************************************************************/
+enuErrorStatus_t Display_Init(void)
+{
+   uint8_t u8Row;
+
+   STimer_Stop(&Gstr_DisplayRowTimer);
+   STimer_Stop(&Gstr_DisplayBlankTimer);
+   for (u8Row=0;u8Row<DISPLAY_ROWS;u8Row++)
+   {
+      Gau8_DisplayFrames[0][u8Row]=0;
+      Gau8_DisplayFrames[1][u8Row]=0;
+      Gau8_DisplayLevel[u8Row]=DISPLAY_FULL;
+      Gau16_DisplayOnUs[u8Row]=DISPLAY_SLOT_US;
+   }
+   Gu8_DisplayFront=0;
+   Gu8_DisplaySwap=0;
+   Gu8_DisplayRow=DISPLAY_ROWS-1;
+   //all segments and rows off, then outputs
+   DISPLAY_ROWS_OFF();
+   DISPLAY_SEG_PORT_R=DISPLAY_SEG_VALUE(0);
+   DISPLAY_SEG_DDR_R=0xFF;
+   Atomic_SetBits8(&DISPLAY_ROW_DDR_R,DISPLAY_ROW_MASK);
+   if (STimer_Create(&Gstr_DisplayRowTimer,DISPLAY_SLOT_US,DISPLAY_SLOT_US,Display_Refresh,NULLPTR) == ERROR)
+   {
+      return ERROR;
+   }
+   //a late slot is shown once and the rows keep their order
+   STimer_SetOverrunPolicy(&Gstr_DisplayRowTimer,STIMER_OVERRUN_SKIP);
+   return STimer_Restart(&Gstr_DisplayRowTimer);
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop the refresh and turn every row off
+************************************************************************************/
+enuErrorStatus_t Display_Stop(void)
+{
+   uint8_t u8Sreg;
+   ATOMIC_ENTER(u8Sreg);
+   STimer_Stop(&Gstr_DisplayRowTimer);
+   STimer_Stop(&Gstr_DisplayBlankTimer);
+   DISPLAY_ROWS_OFF();
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t** ppu8Frame
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (a swap is still pending)
+* Description: A function to get the back buffer, DISPLAY_ROWS bytes of segments (bit 0 segment a
+*              or column 0, 1 lit)
+************************************************************************************/
+enuErrorStatus_t Display_GetBackBuffer(uint8_t** ppu8Frame)
+{
+   if (ppu8Frame == NULLPTR || Gu8_DisplaySwap)
+   {
+      return ERROR;
+   }
+   *ppu8Frame=Gau8_DisplayFrames[Gu8_DisplayFront^1];
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Digit, uint8_t u8Value
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to draw a 7-segment digit in the back buffer, u8Value 0-15 or
+*              DISPLAY_DIGIT_BLANK/MINUS, DISPLAY_DP or'ed in adds the decimal point
+************************************************************************************/
+enuErrorStatus_t Display_SetDigit(uint8_t u8Digit, uint8_t u8Value)
+{
+   uint8_t* pu8Frame;
+   if (u8Digit >= DISPLAY_ROWS || (u8Value & (uint8_t)~DISPLAY_DP) >= DISPLAY_FONT_SIZE ||
+       Display_GetBackBuffer(&pu8Frame) == ERROR)
+   {
+      return ERROR;
+   }
+   pu8Frame[u8Digit]=Gau8_DisplayFont[u8Value & (uint8_t)~DISPLAY_DP] | (u8Value & DISPLAY_DP);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (a swap is still pending)
+* Description: A function to show the back buffer from the start of the next refresh frame
+************************************************************************************/
+enuErrorStatus_t Display_Swap(void)
+{
+   if (Gu8_DisplaySwap)
+   {
+      return ERROR;
+   }
+   //one byte, the refresh takes it at its next row 0
+   Gu8_DisplaySwap=1;
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Row, uint8_t u8Level
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set the brightness of a row (DISPLAY_ALL_ROWS for all), 0 off to 255 full
+************************************************************************************/
+enuErrorStatus_t Display_SetBrightness(uint8_t u8Row, uint8_t u8Level)
+{
+   uint8_t u8Sreg;
+   uint8_t u8First=u8Row;
+   uint8_t u8Last=u8Row;
+
+   if (u8Row == DISPLAY_ALL_ROWS)
+   {
+      u8First=0;
+      u8Last=DISPLAY_ROWS-1;
+   }
+   else if (u8Row >= DISPLAY_ROWS)
+   {
+      return ERROR;
+   }
+   for (u8Row=u8First;u8Row<=u8Last;u8Row++)
+   {
+      //the refresh reads both in interrupt context
+      ATOMIC_ENTER(u8Sreg);
+      Gau16_DisplayOnUs[u8Row]=(uint16_t)((DISPLAY_SLOT_US*u8Level+DISPLAY_FULL/2)/(DISPLAY_FULL+1));
+      Gau8_DisplayLevel[u8Row]=u8Level;
+      ATOMIC_EXIT(u8Sreg);
+   }
+   return SUCCESS;
+}
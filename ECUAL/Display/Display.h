@@ -0,0 +1,116 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: Display.h
+* Description: File containing function prototypes for Display.c
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __DISPLAY__
+#define __DISPLAY__
+
+#include "DataTypes.h"
+#include "Utils.h"
+#include "Register.h"
+#include "Atomic.h"
+#include "STimer.h"
+
+/*
+ * Multiplexed 7-segment digits or LED matrix rows.
+ * The segments (or columns) of every row share DISPLAY_SEG_PORT and each row has its select
+ * line on DISPLAY_ROW_PORT (bits 0 to DISPLAY_ROWS-1). A periodic software timer lights one row
+ * per tick from the front frame buffer with port wide writes: rows off, segments of the next
+ * row, its select on, so the refresh runs in interrupt context whatever the main loop does.
+ * A whole frame is DISPLAY_REFRESH_HZ, each row gets 1/DISPLAY_ROWS of it.
+ *
+ * Brightness is the on time of a row in its slot: a one shot software timer turns the row off
+ * level/256 of the slot after it was lit (255 keeps it on for the whole slot, 0 never lights
+ * it). The timer resolution and interrupt latency make levels below ~10 uneven.
+ *
+ * Frames are double buffered: the application draws into the back buffer (Display_GetBackBuffer,
+ * Display_SetDigit) and Display_Swap hands it over, the refresh takes it at the start of its
+ * next frame so a frame is never shown half old and half new. Until then the back buffer can
+ * not be drawn into, after it holds the frame before the last one.
+ *
+ * STimer_Init has to be called first (timer 1 time base). Each row costs one timer interrupt
+ * and one more for the blanking when dimmed, ~2 interrupts per ms for 4 digits at 100 Hz.
+ */
+
+//configuration
+#define DISPLAY_ROWS             4           //digits or matrix rows, up to 8
+#define DISPLAY_REFRESH_HZ       100UL       //whole frames per second
+#define DISPLAY_SEG_PORT_R       PORTA_R
+#define DISPLAY_SEG_DDR_R        DDRA_R
+#define DISPLAY_ROW_PORT_R       PORTC_R
+#define DISPLAY_ROW_DDR_R        DDRC_R
+#define DISPLAY_SEG_ACTIVE_LOW   0           //1 for common anode digits driven directly
+#define DISPLAY_ROW_ACTIVE_LOW   0           //1 for PNP or P-MOSFET row drivers
+
+#if DISPLAY_ROWS < 1 || DISPLAY_ROWS > 8
+#error "Display: DISPLAY_ROWS must be 1 to 8, the row selects are bits of one port"
+#endif
+
+#define DISPLAY_SLOT_US          (1000000UL/(DISPLAY_REFRESH_HZ*DISPLAY_ROWS))
+
+#if DISPLAY_SLOT_US > 0xFFFFUL
+#error "Display: the row slot is kept in 16 bits, raise DISPLAY_REFRESH_HZ"
+#endif
+#define DISPLAY_ALL_ROWS         0xFF
+
+//7-segment values of Display_SetDigit besides 0-15 (hex digits)
+#define DISPLAY_DIGIT_BLANK      16
+#define DISPLAY_DIGIT_MINUS      17
+//decimal point bit of a 7-segment value (segments a-g are bits 0-6)
+#define DISPLAY_DP               0x80
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set up the ports and start the refresh with blank frames at full brightness
+************************************************************************************/
+enuErrorStatus_t Display_Init(void);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop the refresh and turn every row off
+************************************************************************************/
+enuErrorStatus_t Display_Stop(void);
+
+/************************************************************************************
+* Parameters (in): uint8_t** ppu8Frame
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (a swap is still pending)
+* Description: A function to get the back buffer, DISPLAY_ROWS bytes of segments (bit 0 segment a
+*              or column 0, 1 lit)
+************************************************************************************/
+enuErrorStatus_t Display_GetBackBuffer(uint8_t** ppu8Frame);
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Digit, uint8_t u8Value
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to draw a 7-segment digit in the back buffer, u8Value 0-15 or
+*              DISPLAY_DIGIT_BLANK/MINUS, DISPLAY_DP or'ed in adds the decimal point
+************************************************************************************/
+enuErrorStatus_t Display_SetDigit(uint8_t u8Digit, uint8_t u8Value);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (a swap is still pending)
+* Description: A function to show the back buffer from the start of the next refresh frame
+************************************************************************************/
+enuErrorStatus_t Display_Swap(void);
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Row, uint8_t u8Level
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set the brightness of a row (DISPLAY_ALL_ROWS for all), 0 off to 255 full
+************************************************************************************/
+enuErrorStatus_t Display_SetBrightness(uint8_t u8Row, uint8_t u8Level);
+
+#endif /* __DISPLAY__ */
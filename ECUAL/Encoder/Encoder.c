@@ -0,0 +1,193 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: Encoder.c
+* Description: File containing the quadrature encoder driver functions
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#include "Encoder.h"
+
+#define USEC_TO_SEC           1000000UL
+#define ENCODER_PINS_MASK     ((1<<ENCODER_A_PIN) | (1<<ENCODER_B_PIN))
+
+//count change for every (previous BA << 2 | current BA) transition, invalid double steps count 0
+const sint8_t Gs8_EncoderTable[16]=
+{
+    0, -1,  1,  0,
+    1,  0,  0, -1,
+   -1,  0,  0,  1,
+    0,  1, -1,  0
+};
+
+//last transition index, the low 2 bits hold the current BA state
+volatile uint8_t  Gu8_EncoderState=0;
+//raw count updated by the ISR
+volatile uint16_t Gu16_EncoderRaw=0;
+
+//32 bit position up to the raw count Gu16_EncoderRawBase
+sint32_t Gs32_EncoderPosition=0;
+uint16_t Gu16_EncoderRawBase=0;
+//raw count at the last velocity update
+uint16_t Gu16_EncoderVelBase=0;
+sint32_t Gs32_EncoderVelocity=0;
+uint32_t Gu32_EncoderVelScale=0;
+
+
+/******************** Private Functions ****************************************/
+
+//fold what the ISR counted since the last extension into the 32 bit position, interrupts masked
+static void Encoder_Extend(uint16_t u16Raw)
+{
+   Gs32_EncoderPosition+=(sint16_t)(u16Raw-Gu16_EncoderRawBase);
+   Gu16_EncoderRawBase=u16Raw;
+}
+
+//decode one transition, shared by both external interrupts
+static inline void Encoder_Decode(void) __attribute__((always_inline));
+static inline void Encoder_Decode(void)
+{
+   uint8_t u8State=((Gu8_EncoderState<<2) | ((PIND_R>>ENCODER_A_PIN) & 0x03)) & 0x0F;
+   Gu8_EncoderState=u8State;
+   Gu16_EncoderRaw+=Gs8_EncoderTable[u8State];
+}
+
+
+/************************************************************************************
+* Parameters (in): uint32_t u32VelocityPeriodUs
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to initialize the encoder inputs and interrupts, u32VelocityPeriodUs is the
+*              period Encoder_VelocityUpdate will be called at and must divide 1000000
+************************************************************************************/
+enuErrorStatus_t Encoder_Init(uint32_t u32VelocityPeriodUs)
+{
+   //the period has to divide a second so the velocity is a single multiplication
+   if (u32VelocityPeriodUs == 0 || (USEC_TO_SEC % u32VelocityPeriodUs) != 0)
+   {
+      return ERROR;
+   }
+   Gu32_EncoderVelScale=USEC_TO_SEC/u32VelocityPeriodUs;
+
+   //disable both interrupts while configuring
+   CLR_BIT(GICR_R,INT0_B);
+   CLR_BIT(GICR_R,INT1_B);
+
+   //set both channels as inputs with pull ups
+   DDRD_R  &= ~ENCODER_PINS_MASK;
+   PORTD_R |=  ENCODER_PINS_MASK;
+
+   //reset the position and take the current state as the starting point
+   Gu8_EncoderState=(PIND_R>>ENCODER_A_PIN) & 0x03;
+   Gu16_EncoderRaw=0;
+   Gu16_EncoderRawBase=0;
+   Gu16_EncoderVelBase=0;
+   Gs32_EncoderPosition=0;
+   Gs32_EncoderVelocity=0;
+
+   //trigger both interrupts on any logical change
+   SET_BIT(MCUCR_R,ISC00_B);
+   CLR_BIT(MCUCR_R,ISC01_B);
+   SET_BIT(MCUCR_R,ISC10_B);
+   CLR_BIT(MCUCR_R,ISC11_B);
+
+   //clear the pending flags and enable the interrupts
+   GIFR_R=(1<<INTF0_B) | (1<<INTF1_B);
+   SET_BIT(GICR_R,INT0_B);
+   SET_BIT(GICR_R,INT1_B);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): sint32_t* ps32Position
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the 32 bit encoder position in counts
+************************************************************************************/
+enuErrorStatus_t Encoder_GetPosition(sint32_t* ps32Position)
+{
+   uint8_t u8Sreg;
+   if (ps32Position == NULLPTR)
+   {
+      return ERROR;
+   }
+   //the velocity update may run from a timer interrupt, so extend and read with interrupts masked
+   ATOMIC_ENTER(u8Sreg);
+   Encoder_Extend(Gu16_EncoderRaw);
+   *ps32Position=Gs32_EncoderPosition;
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): sint32_t s32Position
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set the encoder position (e.g. zero it on a home switch)
+************************************************************************************/
+enuErrorStatus_t Encoder_SetPosition(sint32_t s32Position)
+{
+   uint8_t u8Sreg;
+   ATOMIC_ENTER(u8Sreg);
+   Gu16_EncoderRawBase=Gu16_EncoderRaw;
+   Gs32_EncoderPosition=s32Position;
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): void
+* Return value: void
+* Description: A function to sample the velocity, to be called from a periodic timer callback
+*              (e.g. T0_Start(u32VelocityPeriodUs,Encoder_VelocityUpdate))
+************************************************************************************/
+void Encoder_VelocityUpdate(void)
+{
+   uint16_t u16Raw;
+   sint16_t s16Delta;
+   uint8_t u8Sreg;
+   //the raw count is 16 bits wide and shared with the ISR, so update with interrupts masked
+   ATOMIC_ENTER(u8Sreg);
+   u16Raw=Gu16_EncoderRaw;
+   //the position has its own base, Encoder_GetPosition may have extended it during the period
+   Encoder_Extend(u16Raw);
+   s16Delta=(sint16_t)(u16Raw-Gu16_EncoderVelBase);
+   Gu16_EncoderVelBase=u16Raw;
+   ATOMIC_EXIT(u8Sreg);
+   Gs32_EncoderVelocity=(sint32_t)s16Delta*(sint32_t)Gu32_EncoderVelScale;
+}
+
+/************************************************************************************
+* Parameters (in): sint32_t* ps32CountsPerSec
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the velocity measured over the last update period in counts/s
+************************************************************************************/
+enuErrorStatus_t Encoder_GetVelocity(sint32_t* ps32CountsPerSec)
+{
+   uint8_t u8Sreg;
+   if (ps32CountsPerSec == NULLPTR)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   *ps32CountsPerSec=Gs32_EncoderVelocity;
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+
+/******************** ISR FUNCTIONS ****************************************/
+
+//ISR function to run on any change of channel A
+ISR(INT0_vect)
+{
+   Encoder_Decode();
+}
+
+//ISR function to run on any change of channel B
+ISR(INT1_vect)
+{
+   Encoder_Decode();
+}
@@ -0,0 +1,74 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: Encoder.h
+* Description: File containing function prototypes for Encoder.c
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __ENCODER__
+#define __ENCODER__
+
+#include "DataTypes.h"
+#include "Utils.h"
+#include "Register.h"
+#include "Atomic.h"
+
+/*
+ * Quadrature encoder on INT0 (PD2, channel A) and INT1 (PD3, channel B).
+ * Both interrupts fire on any logical change and decode the A/B transition with a
+ * 16 entry lookup table (4x decoding). The ISR only updates a 16 bit count, the 32 bit
+ * position is extended from it outside the ISR by Encoder_GetPosition and
+ * Encoder_VelocityUpdate, so one of them has to run at least once every 32767 counts.
+ *
+ * ISR cost (instruction count of the -Os output, entry to reti): about 67 cycles per edge,
+ * so the count rate is limited to roughly F_CPU/67: ~119k counts/s at 8 MHz with the CPU
+ * fully loaded, 100k counts/s takes ~42% of the CPU at 16 MHz.
+ */
+
+#define ENCODER_A_PIN      2     //PD2 / INT0
+#define ENCODER_B_PIN      3     //PD3 / INT1
+
+/************************************************************************************
+* Parameters (in): uint32_t u32VelocityPeriodUs
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to initialize the encoder inputs and interrupts, u32VelocityPeriodUs is the
+*              period Encoder_VelocityUpdate will be called at and must divide 1000000
+************************************************************************************/
+enuErrorStatus_t Encoder_Init(uint32_t u32VelocityPeriodUs);
+
+/************************************************************************************
+* Parameters (in): sint32_t* ps32Position
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the 32 bit encoder position in counts
+************************************************************************************/
+enuErrorStatus_t Encoder_GetPosition(sint32_t* ps32Position);
+
+/************************************************************************************
+* Parameters (in): sint32_t s32Position
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set the encoder position (e.g. zero it on a home switch)
+************************************************************************************/
+enuErrorStatus_t Encoder_SetPosition(sint32_t s32Position);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): void
+* Return value: void
+* Description: A function to sample the velocity, to be called from a periodic timer callback
+*              (e.g. T0_Start(u32VelocityPeriodUs,Encoder_VelocityUpdate))
+************************************************************************************/
+void Encoder_VelocityUpdate(void);
+
+/************************************************************************************
+* Parameters (in): sint32_t* ps32CountsPerSec
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the velocity measured over the last update period in counts/s
+************************************************************************************/
+enuErrorStatus_t Encoder_GetVelocity(sint32_t* ps32CountsPerSec);
+
+#endif /* __ENCODER__ */
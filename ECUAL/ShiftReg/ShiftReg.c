@@ -0,0 +1,239 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: ShiftReg.c
+* Description: File containing the shift register output expansion functions
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#include "ShiftReg.h"
+
+//outputs of register i in Gau8_ShiftRegImage[i], bit n is Qn
+uint8_t Gau8_ShiftRegImage[SHIFTREG_COUNT];
+//image in send order (last register first), the SPI reads it while the image may change
+uint8_t Gau8_ShiftRegSend[SHIFTREG_COUNT];
+volatile uint8_t Gu8_ShiftRegBusy=0;
+volatile uint8_t Gu8_ShiftRegPending=0;
+strSTimer_t Gstr_ShiftRegRefresh;
+
+
+/******************** Private Functions ****************************************/
+
+static void ShiftReg_Start(void);
+
+//last byte is out: latch, then send again if the image changed meanwhile
+static void ShiftReg_Done(void* pvCtx)
+{
+   (void)pvCtx;
+   //RCLK rising edge, sbi/cbi are 2 cycles, far above the 20 ns the 74HC595 needs
+   SET_BIT(PORTB_R,SPI_SS_PIN);
+   CLR_BIT(PORTB_R,SPI_SS_PIN);
+   Gu8_ShiftRegBusy=0;
+   if (Gu8_ShiftRegPending)
+   {
+      ShiftReg_Start();
+   }
+}
+
+//copy the image and start the transfer, interrupts masked or in interrupt context
+static void ShiftReg_Start(void)
+{
+   uint8_t u8Reg;
+   //the first byte out ends in the last register
+   for (u8Reg=0;u8Reg<SHIFTREG_COUNT;u8Reg++)
+   {
+      Gau8_ShiftRegSend[u8Reg]=Gau8_ShiftRegImage[SHIFTREG_COUNT-1-u8Reg];
+   }
+   Gu8_ShiftRegPending=0;
+   Gu8_ShiftRegBusy=1;
+   if (SPI_Transfer(Gau8_ShiftRegSend,NULLPTR,SHIFTREG_COUNT,ShiftReg_Done,NULLPTR) == ERROR)
+   {
+      //the SPI is taken by another driver, try again on the next flush
+      Gu8_ShiftRegBusy=0;
+      Gu8_ShiftRegPending=1;
+   }
+}
+
+static void ShiftReg_RefreshCallback(void* pvCtx)
+{
+   (void)pvCtx;
+   ShiftReg_Flush();
+}
+
+//update the bit of an expanded pin, u8Op 0 clear, 1 set, 2 toggle
+static enuErrorStatus_t ShiftReg_Update(uint8_t u8Pin, uint8_t u8Op)
+{
+   uint8_t u8Sreg;
+   uint8_t u8Reg;
+   uint8_t u8Mask;
+
+   u8Pin-=SHIFTREG_PIN_BASE;
+   u8Reg=u8Pin/8;
+   u8Mask=(uint8_t)(1<<(u8Pin%8));
+   ATOMIC_ENTER(u8Sreg);
+   if (u8Op == 2)
+   {
+      Gau8_ShiftRegImage[u8Reg]^=u8Mask;
+   }
+   else if (u8Op == 1)
+   {
+      Gau8_ShiftRegImage[u8Reg]|=u8Mask;
+   }
+   else
+   {
+      Gau8_ShiftRegImage[u8Reg]&=(uint8_t)~u8Mask;
+   }
+   ATOMIC_EXIT(u8Sreg);
+#if SHIFTREG_AUTO_FLUSH
+   return ShiftReg_Flush();
+#else
+   return SUCCESS;
+#endif
+}
+
+//1 if u8Pin is an expanded output
+static uint8_t ShiftReg_IsExpanded(uint8_t u8Pin)
+{
+   return u8Pin >= SHIFTREG_PIN_BASE && u8Pin < SHIFTREG_PIN_BASE+SHIFTREG_PINS;
+}
+
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set up the SPI and the latch line and clear every expanded output
+************************************************************************************/
+enuErrorStatus_t ShiftReg_Init(void)
+{
+   uint8_t u8Reg;
+   //latch idle low, SPI_Init makes it an output
+   Atomic_ClearBits8(&PORTB_R,(1<<SPI_SS_PIN));
+   if (SPI_Init(SHIFTREG_SPI_CLOCK,SPI_MODE0,SPI_MSB_FIRST) == ERROR)
+   {
+      return ERROR;
+   }
+   for (u8Reg=0;u8Reg<SHIFTREG_COUNT;u8Reg++)
+   {
+      Gau8_ShiftRegImage[u8Reg]=0;
+   }
+   Gu8_ShiftRegBusy=0;
+   Gu8_ShiftRegPending=0;
+   return ShiftReg_Flush();
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Pin, uint8_t u8Data
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to write a native (enuDIOPinNo_t) or expanded (SHIFTREG_PIN) output
+************************************************************************************/
+enuErrorStatus_t ShiftReg_Write(uint8_t u8Pin, uint8_t u8Data)
+{
+   if (u8Pin < ALL_PINS)
+   {
+      return DIO_Write((enuDIOPinNo_t)u8Pin,u8Data);
+   }
+   if (!ShiftReg_IsExpanded(u8Pin))
+   {
+      return ERROR;
+   }
+   return ShiftReg_Update(u8Pin,u8Data ? 1 : 0);
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Pin
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to toggle a native (enuDIOPinNo_t) or expanded (SHIFTREG_PIN) output
+************************************************************************************/
+enuErrorStatus_t ShiftReg_Toggle(uint8_t u8Pin)
+{
+   if (u8Pin < ALL_PINS)
+   {
+      return DIO_Toggle((enuDIOPinNo_t)u8Pin);
+   }
+   if (!ShiftReg_IsExpanded(u8Pin))
+   {
+      return ERROR;
+   }
+   return ShiftReg_Update(u8Pin,2);
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Pin, uint8_t* pu8Data
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read a native input (DIO_Read) or the image value of an expanded output
+************************************************************************************/
+enuErrorStatus_t ShiftReg_Read(uint8_t u8Pin, uint8_t* pu8Data)
+{
+   if (u8Pin < ALL_PINS)
+   {
+      return DIO_Read((enuDIOPinNo_t)u8Pin,pu8Data);
+   }
+   if (!ShiftReg_IsExpanded(u8Pin) || pu8Data == NULLPTR)
+   {
+      return ERROR;
+   }
+   u8Pin-=SHIFTREG_PIN_BASE;
+   *pu8Data=GET_BIT(Gau8_ShiftRegImage[u8Pin/8],u8Pin%8);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to send the image to the registers in the background, if a flush is
+*              running one more follows it
+************************************************************************************/
+enuErrorStatus_t ShiftReg_Flush(void)
+{
+   uint8_t u8Sreg;
+   ATOMIC_ENTER(u8Sreg);
+   if (Gu8_ShiftRegBusy)
+   {
+      //the done handler starts it, the bytes being sent are a copy of the old image
+      Gu8_ShiftRegPending=1;
+   }
+   else
+   {
+      ShiftReg_Start();
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint32_t u32PeriodUs
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to flush the image every u32PeriodUs from a software timer
+************************************************************************************/
+enuErrorStatus_t ShiftReg_StartRefresh(uint32_t u32PeriodUs)
+{
+   if (u32PeriodUs == 0)
+   {
+      return ERROR;
+   }
+   STimer_Stop(&Gstr_ShiftRegRefresh);
+   if (STimer_Create(&Gstr_ShiftRegRefresh,u32PeriodUs,u32PeriodUs,ShiftReg_RefreshCallback,NULLPTR) == ERROR)
+   {
+      return ERROR;
+   }
+   //a late refresh is one flush however many periods it missed
+   STimer_SetOverrunPolicy(&Gstr_ShiftRegRefresh,STIMER_OVERRUN_SKIP);
+   return STimer_Restart(&Gstr_ShiftRegRefresh);
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop the periodic flush
+************************************************************************************/
+enuErrorStatus_t ShiftReg_StopRefresh(void)
+{
+   return STimer_Stop(&Gstr_ShiftRegRefresh);
+}
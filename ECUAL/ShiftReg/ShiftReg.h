@@ -0,0 +1,112 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: ShiftReg.h
+* Description: File containing function prototypes for ShiftReg.c
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __SHIFTREG__
+#define __SHIFTREG__
+
+#include "DataTypes.h"
+#include "Utils.h"
+#include "Register.h"
+#include "Atomic.h"
+#include "DIO.h"
+#include "SPI.h"
+#include "STimer.h"
+
+/*
+ * Output expansion with a chain of 74HC595 shift registers on the SPI.
+ * MOSI (PB5) goes to SER of the first register, SCK (PB7) to every SRCLK, SS (PB4) to every
+ * RCLK (latch), each QH' to SER of the next register. The outputs are a RAM image, a flush
+ * sends it in the background with SPI_Transfer and pulses the latch when the last byte is out,
+ * so every output changes on the same edge. At clk/2 a 2 register chain is out in ~150 cycles
+ * of interrupt time against ~100 cycles per bit with DIO_Write bit banging.
+ *
+ * Expanded pins are numbered after the native ones, SHIFTREG_PIN(n) is output Qn%8 of register
+ * n/8 (register 0 is the one next to the MCU), and ShiftReg_Write/Toggle/Read take both kinds:
+ *    ShiftReg_Write(PC7,1);                  same as DIO_Write
+ *    ShiftReg_Write(SHIFTREG_PIN(10),1);     QC of the second register
+ * With SHIFTREG_AUTO_FLUSH every change starts a flush (one more follows if a flush is running,
+ * so changes are never lost and bursts share transfers). ShiftReg_StartRefresh also sends the
+ * image periodically from a software timer, which restores outputs upset by noise.
+ */
+
+//configuration
+#define SHIFTREG_COUNT           2           //registers in the chain
+#define SHIFTREG_AUTO_FLUSH      1
+#define SHIFTREG_SPI_CLOCK       SPI_CLOCK_DIV2
+
+#if SHIFTREG_COUNT < 1
+#error "Shift register: SHIFTREG_COUNT must be at least 1"
+#endif
+
+//the expanded pins follow the native ones, PA0..PD7 are 0..ALL_PINS-1
+#define SHIFTREG_PIN_BASE        ALL_PINS
+#define SHIFTREG_PINS            (SHIFTREG_COUNT*8)
+#define SHIFTREG_PIN(n)          ((uint8_t)(SHIFTREG_PIN_BASE+(n)))
+
+//the pins are numbered in 8 bits, a higher one would wrap onto a native pin (28 registers with
+//the 32 native pins), ALL_PINS is an enum so this can not be an #if
+STATIC_ASSERT(SHIFTREG_PIN_BASE+SHIFTREG_PINS-1 <= 0xFF,SHIFTREG_COUNT_too_large);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set up the SPI and the latch line and clear every expanded output
+************************************************************************************/
+enuErrorStatus_t ShiftReg_Init(void);
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Pin, uint8_t u8Data
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to write a native (enuDIOPinNo_t) or expanded (SHIFTREG_PIN) output
+************************************************************************************/
+enuErrorStatus_t ShiftReg_Write(uint8_t u8Pin, uint8_t u8Data);
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Pin
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to toggle a native (enuDIOPinNo_t) or expanded (SHIFTREG_PIN) output
+************************************************************************************/
+enuErrorStatus_t ShiftReg_Toggle(uint8_t u8Pin);
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Pin, uint8_t* pu8Data
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read a native input (DIO_Read) or the image value of an expanded output
+************************************************************************************/
+enuErrorStatus_t ShiftReg_Read(uint8_t u8Pin, uint8_t* pu8Data);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to send the image to the registers in the background, if a flush is
+*              running one more follows it
+************************************************************************************/
+enuErrorStatus_t ShiftReg_Flush(void);
+
+/************************************************************************************
+* Parameters (in): uint32_t u32PeriodUs
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to flush the image every u32PeriodUs from a software timer
+************************************************************************************/
+enuErrorStatus_t ShiftReg_StartRefresh(uint32_t u32PeriodUs);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop the periodic flush
+************************************************************************************/
+enuErrorStatus_t ShiftReg_StopRefresh(void);
+
+#endif /* __SHIFTREG__ */
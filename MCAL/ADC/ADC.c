@@ -0,0 +1,227 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: ADC.c
+* Description: File containing the timer triggered ADC driver functions
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#include "ADC.h"
+
+#define ADC_CHANNELS_NO       8
+#define ADC_TRIGGER_MASK      0xE0
+#define ADC_TRIGGER_SHIFT     5
+
+uint16_t Gau16_AdcBlocks[2][ADC_BLOCK_SIZE];
+//block and position the ISR is filling
+volatile uint8_t  Gu8_AdcFillBlock=0;
+volatile uint8_t  Gu8_AdcFillIndex=0;
+//bit per block, set when the block is full and owned by the main loop
+volatile uint8_t  Gu8_AdcFullMask=0;
+//next block the main loop reads, blocks fill in turn so they are read in turn
+uint8_t           Gu8_AdcReadBlock=0;
+uint8_t           Gu8_AdcBlockHeld=0;
+volatile uint16_t Gu16_AdcDropped=0;
+//TIFR flag of the trigger timer, cleared by the ISR so the next compare match triggers again
+uint8_t           Gu8_AdcTriggerFlag=0;
+
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to enable the ADC with the AVCC reference and the compile time clock prescaler
+************************************************************************************/
+enuErrorStatus_t ADC_Init(void)
+{
+   //AVCC reference, right adjusted result, channel 0
+   ADMUX_R=(1<<REFS0_B);
+   //enable the ADC with the clock prescaler, auto trigger and interrupt are set when sampling starts
+   ADCSRA_R=(1<<ADEN_B) | (1<<ADIF_B) | ADC_PRESCALER_BITS;
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Channel, enuAdcTrigger_t enuTrigger, uint16_t u16SampleRateHz
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to start sampling channel u8Channel (0-7) at u16SampleRateHz, the selected
+*              timer is configured in CTC mode as the trigger and can not be used for anything else
+************************************************************************************/
+enuErrorStatus_t ADC_StartSampling(uint8_t u8Channel, enuAdcTrigger_t enuTrigger, uint16_t u16SampleRateHz)
+{
+   strTimerSolution_t strSolution;
+   enuTimerSolveTimer_t enuTimer;
+   uint8_t  u8TriggerFlag;
+
+   if (u8Channel >= ADC_CHANNELS_NO || u16SampleRateHz == 0 || u16SampleRateHz > ADC_MAX_SAMPLE_RATE)
+   {
+      return ERROR;
+   }
+   switch (enuTrigger)
+   {
+      case ADC_TRIGGER_TIMER0_COMPARE:    enuTimer=TIMERSOLVE_TIMER0;   u8TriggerFlag=(1<<OCF0_B);    break;
+      case ADC_TRIGGER_TIMER1_COMPARE_B:  enuTimer=TIMERSOLVE_TIMER1;   u8TriggerFlag=(1<<OCF1B_B);   break;
+      default:
+      return ERROR;
+      break;
+   }
+
+   //closest sample period the timer can make with one compare match per sample
+   if (TimerSolve(enuTimer,TIMERSOLVE_CTC,(F_CPU+u16SampleRateHz/2)/u16SampleRateHz,1,1,&strSolution) == ERROR)
+   {
+      return ERROR;
+   }
+
+   //stop the previous trigger timer before switching to the new one
+   ADC_StopSampling();
+   Gu8_AdcTriggerFlag=u8TriggerFlag;
+   //reset the blocks
+   Gu8_AdcFillBlock=0;
+   Gu8_AdcFillIndex=0;
+   Gu8_AdcFullMask=0;
+   Gu8_AdcReadBlock=0;
+   Gu8_AdcBlockHeld=0;
+   Gu16_AdcDropped=0;
+
+   //select the channel and the trigger source
+   ADMUX_R=(ADMUX_R & 0xE0) | u8Channel;
+   SFIOR_R=(SFIOR_R & ~ADC_TRIGGER_MASK) | ((uint8_t)enuTrigger<<ADC_TRIGGER_SHIFT);
+   //auto trigger with the conversion complete interrupt, clearing any stale result flag
+   ADCSRA_R|=(1<<ADATE_B) | (1<<ADIE_B) | (1<<ADIF_B);
+
+   //start the trigger timer in CTC mode
+   TIFR_R=Gu8_AdcTriggerFlag;
+   if (enuTrigger == ADC_TRIGGER_TIMER0_COMPARE)
+   {
+      TCNT0_R=0;
+      OCR0_R=(uint8_t)strSolution.u16Top;
+      T0_Init(TIMER0_CTC_MODE,(enuTimer0Scaler_t)strSolution.u8Scaler);
+   }
+   else
+   {
+      TCNT1_R=0;
+      OCR1A_R=strSolution.u16Top;
+      //compare B at TOP as well, it is the trigger source
+      OCR1B_R=strSolution.u16Top;
+      Timer1_Init(TIMER1_CTC_OCRA_TOP_MODE,(enuTimer1Scaler_t)strSolution.u8Scaler);
+   }
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop sampling and the trigger timer
+************************************************************************************/
+enuErrorStatus_t ADC_StopSampling(void)
+{
+   //stop auto triggering and the interrupt
+   ADCSRA_R&=~((1<<ADATE_B) | (1<<ADIE_B));
+   //stop whichever timer was the trigger
+   if (Gu8_AdcTriggerFlag == (1<<OCF0_B))
+   {
+      T0_Init(TIMER0_NORMAL_MODE,TIMER0_STOP);
+   }
+   else if (Gu8_AdcTriggerFlag == (1<<OCF1B_B))
+   {
+      Timer1_Init(TIMER1_NORMAL_MODE,TIMER1_STOP);
+   }
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): const uint16_t** ppu16Block
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (no full block yet)
+* Description: A function to get the oldest full block of ADC_BLOCK_SIZE samples without copying,
+*              the block belongs to the caller until ADC_ReleaseBlock is called
+************************************************************************************/
+enuErrorStatus_t ADC_GetBlock(const uint16_t** ppu16Block)
+{
+   if (ppu16Block == NULLPTR || !GET_BIT(Gu8_AdcFullMask,Gu8_AdcReadBlock))
+   {
+      return ERROR;
+   }
+   Gu8_AdcBlockHeld=1;
+   *ppu16Block=Gau16_AdcBlocks[Gu8_AdcReadBlock];
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (no block held)
+* Description: A function to give the block taken by ADC_GetBlock back to the ISR
+************************************************************************************/
+enuErrorStatus_t ADC_ReleaseBlock(void)
+{
+   uint8_t u8Sreg;
+   if (Gu8_AdcBlockHeld == 0)
+   {
+      return ERROR;
+   }
+   //the mask is also written by the ISR, clear the bit with interrupts masked
+   ATOMIC_ENTER(u8Sreg);
+   CLR_BIT(Gu8_AdcFullMask,Gu8_AdcReadBlock);
+   ATOMIC_EXIT(u8Sreg);
+   Gu8_AdcBlockHeld=0;
+   Gu8_AdcReadBlock^=1;
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint16_t* pu16Dropped
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the number of samples dropped because both blocks were full
+************************************************************************************/
+enuErrorStatus_t ADC_GetDropped(uint16_t* pu16Dropped)
+{
+   uint8_t u8Sreg;
+   if (pu16Dropped == NULLPTR)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   *pu16Dropped=Gu16_AdcDropped;
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+
+/******************** Interrupt Handlers ****************************************/
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Conversion complete handler, stores the triggered conversion result in the fill block
+************************************************************************************/
+void ADC_Handler(void* pvCtx)
+{
+   uint8_t  u8Block=Gu8_AdcFillBlock;
+   uint8_t  u8Index;
+   uint16_t u16Sample=ADC_R;
+   //clear the compare flag, the auto trigger starts a conversion on its rising edge only
+   TIFR_R=Gu8_AdcTriggerFlag;
+
+   //the block is still held by the main loop, drop the sample
+   if (GET_BIT(Gu8_AdcFullMask,u8Block))
+   {
+      Gu16_AdcDropped++;
+      return;
+   }
+   u8Index=Gu8_AdcFillIndex;
+   Gau16_AdcBlocks[u8Block][u8Index]=u16Sample;
+   u8Index++;
+   if (u8Index == ADC_BLOCK_SIZE)
+   {
+      //hand the block over and continue in the other one
+      SET_BIT(Gu8_AdcFullMask,u8Block);
+      Gu8_AdcFillBlock=u8Block^1;
+      u8Index=0;
+   }
+   Gu8_AdcFillIndex=u8Index;
+}
@@ -0,0 +1,123 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: ADC.h
+* Description: File containing function prototypes for ADC.c
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __ADC__
+#define __ADC__
+
+#include "DataTypes.h"
+#include "Utils.h"
+#include "Register.h"
+#include "Atomic.h"
+#include "Timer.h"
+
+/*
+ * Timer triggered ADC sampling.
+ * A timer compare match starts every conversion through the ADC auto trigger (SFIOR ADTS bits),
+ * so the sample instants depend only on the timer and not on interrupt latency. The ADC
+ * interrupt stores the results into two ping-pong blocks, a full block is handed to the main
+ * loop by pointer and given back with ADC_ReleaseBlock. If the main loop holds the block the
+ * ISR needs next, samples are dropped and counted instead of overwriting data being read.
+ */
+
+//configuration
+#define ADC_BLOCK_SIZE           32
+#define ADC_CLOCK_MAX_HZ         200000UL     //highest ADC clock for full 10 bit resolution
+
+//smallest ADC clock prescaler keeping the ADC clock within ADC_CLOCK_MAX_HZ
+#if   (F_CPU/2UL)  <= ADC_CLOCK_MAX_HZ
+#define ADC_PRESCALER            2UL
+#define ADC_PRESCALER_BITS       1
+#elif (F_CPU/4UL)  <= ADC_CLOCK_MAX_HZ
+#define ADC_PRESCALER            4UL
+#define ADC_PRESCALER_BITS       2
+#elif (F_CPU/8UL)  <= ADC_CLOCK_MAX_HZ
+#define ADC_PRESCALER            8UL
+#define ADC_PRESCALER_BITS       3
+#elif (F_CPU/16UL) <= ADC_CLOCK_MAX_HZ
+#define ADC_PRESCALER            16UL
+#define ADC_PRESCALER_BITS       4
+#elif (F_CPU/32UL) <= ADC_CLOCK_MAX_HZ
+#define ADC_PRESCALER            32UL
+#define ADC_PRESCALER_BITS       5
+#elif (F_CPU/64UL) <= ADC_CLOCK_MAX_HZ
+#define ADC_PRESCALER            64UL
+#define ADC_PRESCALER_BITS       6
+#else
+#define ADC_PRESCALER            128UL
+#define ADC_PRESCALER_BITS       7
+#endif
+
+//an auto triggered conversion takes 13.5 ADC clocks
+#define ADC_MAX_SAMPLE_RATE      ((F_CPU/ADC_PRESCALER*2UL)/27UL)
+
+typedef enum
+{
+   ADC_TRIGGER_TIMER0_COMPARE=3,
+   ADC_TRIGGER_TIMER1_COMPARE_B=5
+
+}enuAdcTrigger_t;
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to enable the ADC with the AVCC reference and the compile time clock prescaler
+************************************************************************************/
+enuErrorStatus_t ADC_Init(void);
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Channel, enuAdcTrigger_t enuTrigger, uint16_t u16SampleRateHz
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to start sampling channel u8Channel (0-7) at u16SampleRateHz, the selected
+*              timer is configured in CTC mode as the trigger and can not be used for anything else
+************************************************************************************/
+enuErrorStatus_t ADC_StartSampling(uint8_t u8Channel, enuAdcTrigger_t enuTrigger, uint16_t u16SampleRateHz);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop sampling and the trigger timer
+************************************************************************************/
+enuErrorStatus_t ADC_StopSampling(void);
+
+/************************************************************************************
+* Parameters (in): const uint16_t** ppu16Block
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (no full block yet)
+* Description: A function to get the oldest full block of ADC_BLOCK_SIZE samples without copying,
+*              the block belongs to the caller until ADC_ReleaseBlock is called
+************************************************************************************/
+enuErrorStatus_t ADC_GetBlock(const uint16_t** ppu16Block);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (no block held)
+* Description: A function to give the block taken by ADC_GetBlock back to the ISR
+************************************************************************************/
+enuErrorStatus_t ADC_ReleaseBlock(void);
+
+/************************************************************************************
+* Parameters (in): uint16_t* pu16Dropped
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the number of samples dropped because both blocks were full
+************************************************************************************/
+enuErrorStatus_t ADC_GetDropped(uint16_t* pu16Dropped);
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Conversion complete handler, stores the triggered conversion result in the fill block
+************************************************************************************/
+void ADC_Handler(void* pvCtx);
+
+#endif /* __ADC__ */
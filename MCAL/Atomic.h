@@ -0,0 +1,132 @@
+/*****************************************************************************
+* Task: AVR_DRIVERS
+* File Name: Atomic.h
+* Description: File for critical sections and atomic access helpers
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __ATOMIC__
+#define __ATOMIC__
+
+#include "DataTypes.h"
+#include "Register.h"
+
+/*
+ * The AVR core moves one byte at a time, so any variable or register wider than 8 bits that
+ * an ISR also touches can be torn, and a read-modify-write of a shared register (TIMSK,
+ * TIFR...) can lose an update made by an ISR between the read and the write.
+ *
+ * ATOMIC_ENTER/ATOMIC_EXIT save SREG, mask interrupts and restore the previous state, so
+ * they nest and are safe inside ISRs. Both are compiler memory barriers. Keep the section to
+ * the few instructions that need it: a 16 bit copy masks interrupts for ~6 cycles, 32 bits ~10.
+ *
+ * Single byte variables need no section: one lds/sts is atomic. Hand data from an ISR to
+ * the main loop by writing the data first and publishing a byte flag after it
+ * (Atomic_FlagPublish), the reader checks the flag before touching the data (Atomic_FlagCheck)
+ * and releases it only after the data has been read (Atomic_FlagRelease).
+ *
+ * 16 bit timer registers share one TEMP byte for the high byte, so they are accessed through
+ * Atomic_Reg16Read/Atomic_Reg16Write, the compiler orders the bytes for volatile accesses
+ * (low byte first on reads, high byte first on writes).
+ */
+
+#define ATOMIC_BARRIER()         __asm__ __volatile__ ("" ::: "memory")
+
+#define ATOMIC_ENTER(u8Sreg)     do{ (u8Sreg)=SREG_R; __asm__ __volatile__ ("cli" ::: "memory"); }while(0)
+#define ATOMIC_EXIT(u8Sreg)      do{ ATOMIC_BARRIER(); SREG_R=(u8Sreg); }while(0)
+
+static inline uint16_t Atomic_Read16(const volatile uint16_t* pu16Var)
+{
+   uint8_t  u8Sreg;
+   uint16_t u16Value;
+   ATOMIC_ENTER(u8Sreg);
+   u16Value=*pu16Var;
+   ATOMIC_EXIT(u8Sreg);
+   return u16Value;
+}
+
+static inline void Atomic_Write16(volatile uint16_t* pu16Var, uint16_t u16Value)
+{
+   uint8_t u8Sreg;
+   ATOMIC_ENTER(u8Sreg);
+   *pu16Var=u16Value;
+   ATOMIC_EXIT(u8Sreg);
+}
+
+static inline uint32_t Atomic_Read32(const volatile uint32_t* pu32Var)
+{
+   uint8_t  u8Sreg;
+   uint32_t u32Value;
+   ATOMIC_ENTER(u8Sreg);
+   u32Value=*pu32Var;
+   ATOMIC_EXIT(u8Sreg);
+   return u32Value;
+}
+
+static inline void Atomic_Write32(volatile uint32_t* pu32Var, uint32_t u32Value)
+{
+   uint8_t u8Sreg;
+   ATOMIC_ENTER(u8Sreg);
+   *pu32Var=u32Value;
+   ATOMIC_EXIT(u8Sreg);
+}
+
+static inline uint16_t Atomic_Reg16Read(volatile unsigned short* pu16Reg)
+{
+   uint8_t  u8Sreg;
+   uint16_t u16Value;
+   ATOMIC_ENTER(u8Sreg);
+   u16Value=*pu16Reg;
+   ATOMIC_EXIT(u8Sreg);
+   return u16Value;
+}
+
+static inline void Atomic_Reg16Write(volatile unsigned short* pu16Reg, uint16_t u16Value)
+{
+   uint8_t u8Sreg;
+   ATOMIC_ENTER(u8Sreg);
+   *pu16Reg=u16Value;
+   ATOMIC_EXIT(u8Sreg);
+}
+
+//read-modify-write of a register or variable shared with an ISR
+static inline void Atomic_SetBits8(volatile uint8_t* pu8Reg, uint8_t u8Mask)
+{
+   uint8_t u8Sreg;
+   ATOMIC_ENTER(u8Sreg);
+   *pu8Reg|=u8Mask;
+   ATOMIC_EXIT(u8Sreg);
+}
+
+static inline void Atomic_ClearBits8(volatile uint8_t* pu8Reg, uint8_t u8Mask)
+{
+   uint8_t u8Sreg;
+   ATOMIC_ENTER(u8Sreg);
+   *pu8Reg&=(uint8_t)~u8Mask;
+   ATOMIC_EXIT(u8Sreg);
+}
+
+//producer side of a flag handoff: everything written before is visible once the flag is seen
+static inline void Atomic_FlagPublish(volatile uint8_t* pu8Flag)
+{
+   ATOMIC_BARRIER();
+   *pu8Flag=1;
+}
+
+//consumer side of a flag handoff: returns 1 if the data behind the flag can be read
+static inline uint8_t Atomic_FlagCheck(const volatile uint8_t* pu8Flag)
+{
+   uint8_t u8Flag=*pu8Flag;
+   ATOMIC_BARRIER();
+   return u8Flag;
+}
+
+//consumer side of a flag handoff: gives the data back to the producer once it has been read
+static inline void Atomic_FlagRelease(volatile uint8_t* pu8Flag)
+{
+   ATOMIC_BARRIER();
+   *pu8Flag=0;
+}
+
+#endif /* __ATOMIC__ */
@@ -0,0 +1,63 @@
+/*****************************************************************************
+* Task: AVR_DRIVERS
+* File Name: Clock.h
+* Description: File for the constants derived from the CPU clock
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __CLOCK__
+#define __CLOCK__
+
+#include "DataTypes.h"
+#include "Register.h"
+
+/*
+ * F_CPU is set in Register.h and can be overridden per board on the compiler command line
+ * (-DF_CPU=16000000UL). Everything the drivers need from it is derived here at compile time.
+ * The micro second conversions are shifts when the clock is a power of two MHz (1, 2, 4, 8,
+ * 16), else a multiplication and a division by a constant.
+ *
+ * OSC_CORRECT/OSC_UNCORRECT scale a count computed from F_CPU to the RC clock Osc.c measured and
+ * back. They are only functions with OSC_TIMER_CORRECTION defined, else they cost nothing and the
+ * timer drivers do not depend on the Osc driver.
+ */
+
+#if (F_CPU % 1000000UL) != 0 || F_CPU < 1000000UL || F_CPU > 16000000UL
+#error "Clock: F_CPU must be a whole number of MHz from 1 to 16"
+#endif
+
+#define CLOCK_MHZ                (F_CPU/1000000UL)
+
+#if   CLOCK_MHZ == 1
+#define CLOCK_MHZ_SHIFT          0
+#elif CLOCK_MHZ == 2
+#define CLOCK_MHZ_SHIFT          1
+#elif CLOCK_MHZ == 4
+#define CLOCK_MHZ_SHIFT          2
+#elif CLOCK_MHZ == 8
+#define CLOCK_MHZ_SHIFT          3
+#elif CLOCK_MHZ == 16
+#define CLOCK_MHZ_SHIFT          4
+#endif
+
+#ifdef CLOCK_MHZ_SHIFT
+#define CLOCK_US_TO_CYCLES(us)   ((uint32_t)(us)<<CLOCK_MHZ_SHIFT)
+#define CLOCK_CYCLES_TO_US(c)    ((uint32_t)(c)>>CLOCK_MHZ_SHIFT)
+#else
+#define CLOCK_US_TO_CYCLES(us)   ((uint32_t)(us)*CLOCK_MHZ)
+#define CLOCK_CYCLES_TO_US(c)    ((uint32_t)(c)/CLOCK_MHZ)
+#endif
+
+//counts computed from F_CPU corrected to the measured clock, see Osc.h
+#ifdef OSC_TIMER_CORRECTION
+uint32_t Osc_NominalToActual(uint32_t u32Count);
+uint32_t Osc_ActualToNominal(uint32_t u32Count);
+#define OSC_CORRECT(n)           Osc_NominalToActual(n)
+#define OSC_UNCORRECT(n)         Osc_ActualToNominal(n)
+#else
+#define OSC_CORRECT(n)           (n)
+#define OSC_UNCORRECT(n)         (n)
+#endif
+
+#endif /* __CLOCK__ */
@@ -0,0 +1,314 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: Counter.c
+* Description: File containing the timer 0 event counter and frequency meter functions
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#include "Counter.h"
+
+#define COUNTER_T0_PIN        0        //T0 input is PB0
+#define COUNTER_HALF_RANGE    0x80
+
+//threshold states
+#define COUNTER_THR_NONE      0
+#define COUNTER_THR_WAITING   1        //waiting for the overflow block holding the threshold
+#define COUNTER_THR_ARMED     2        //output compare armed on the threshold low byte
+
+//number of completed 256 event blocks, the upper 24 bits of the count
+volatile uint32_t Gu32_CounterHigh=0;
+
+volatile uint32_t Gu32_CounterThreshold=0;
+volatile uint8_t  Gu8_CounterThrState=COUNTER_THR_NONE;
+void (*G_fptrCounterThreshold)(void)=NULLPTR;
+
+volatile uint16_t Gu16_CounterGateMs=0;
+volatile uint16_t Gu16_CounterGateTicks=0;
+volatile uint32_t Gu32_CounterGateStart=0;
+volatile uint32_t Gu32_CounterFreqHz=0;
+volatile uint8_t  Gu8_CounterFreqReady=0;
+void (*G_fptrCounterFreq)(void)=NULLPTR;
+
+
+/******************** Private Functions ****************************************/
+
+//read the 32 bit count, must be called with interrupts disabled
+static uint32_t Counter_ReadRaw(void)
+{
+   uint32_t u32High=Gu32_CounterHigh;
+   uint8_t  u8Low=TCNT0_R;
+   //if an overflow is pending that the ISR has not counted yet and the low byte was read after it
+   if (GET_BIT(TIFR_R,TOV0_B) && u8Low < COUNTER_HALF_RANGE)
+   {
+      u32High++;
+   }
+   return (u32High<<8) | u8Low;
+}
+
+//call the threshold callback once and disarm the compare
+static void Counter_ThresholdFire(void)
+{
+   CLR_BIT(TIMSK_R,OCIE0_B);
+   TIFR_R=(1<<OCF0_B);
+   Gu8_CounterThrState=COUNTER_THR_NONE;
+   if (G_fptrCounterThreshold != NULLPTR)
+   {
+      G_fptrCounterThreshold();
+   }
+}
+
+//arm the output compare on the low byte of the threshold, must be called with interrupts disabled
+static void Counter_ThresholdArm(void)
+{
+   uint8_t u8Low=(uint8_t)Gu32_CounterThreshold;
+   OCR0_R=u8Low;
+   //clear any stale compare flag before enabling the interrupt, TIFR is written (not RMW) so
+   //a pending overflow flag is not cleared with it
+   TIFR_R=(1<<OCF0_B);
+   Gu8_CounterThrState=COUNTER_THR_ARMED;
+   SET_BIT(TIMSK_R,OCIE0_B);
+   //if the counter already ran past the compare value without a flag, the match was lost while arming
+   if (TCNT0_R >= u8Low && !GET_BIT(TIFR_R,OCF0_B))
+   {
+      Counter_ThresholdFire();
+   }
+}
+
+//timer 0 overflow hook, extends the hardware count
+static void Counter_OVHandler(void)
+{
+   Gu32_CounterHigh++;
+   //if the threshold falls in the block that just started, arm the compare on it
+   if (Gu8_CounterThrState==COUNTER_THR_WAITING && Gu32_CounterHigh==(Gu32_CounterThreshold>>8))
+   {
+      Counter_ThresholdArm();
+   }
+}
+
+
+/************************************************************************************
+* Parameters (in): enuCounterEdge_t enuEdge
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to initialize timer 0 as an event counter on the T0 pin and start counting
+************************************************************************************/
+enuErrorStatus_t Counter_Init(enuCounterEdge_t enuEdge)
+{
+   enuTimer0Scaler_t enuScaler;
+   //select the clock source for the requested edge
+   switch (enuEdge)
+   {
+      case COUNTER_FALLING_EDGE:    enuScaler=EXTERNALl_FALLING;    break;
+      case COUNTER_RISING_EDGE:     enuScaler=EXTERNAL_RISING;      break;
+      default:
+      return ERROR;
+      break;
+   }
+   //stop the timer and take over its overflow interrupt
+   T0_Stop();
+   T0_OVHookSet(Counter_OVHandler);
+   //the T0 pin has to be an input for the counter to see the edges
+   CLR_BIT(DDRB_R,COUNTER_T0_PIN);
+
+   //reset the count
+   Gu32_CounterHigh=0;
+   Gu8_CounterThrState=COUNTER_THR_NONE;
+   TCNT0_R=0;
+   TIFR_R=(1<<TOV0_B);
+
+   //enable the overflow interrupt and start counting from the pin
+   T0_OV_InterruptEnable();
+   T0_Init(TIMER0_NORMAL_MODE,enuScaler);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop the event counter and release timer 0
+************************************************************************************/
+enuErrorStatus_t Counter_Stop(void)
+{
+   //stop the clock and the interrupts, then hand the overflow back to the delay logic
+   T0_Stop();
+   T0_OVHookSet(NULLPTR);
+   Gu8_CounterThrState=COUNTER_THR_NONE;
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to reset the event count to zero
+************************************************************************************/
+enuErrorStatus_t Counter_Clear(void)
+{
+   uint8_t u8Sreg;
+   ATOMIC_ENTER(u8Sreg);
+   TCNT0_R=0;
+   TIFR_R=(1<<TOV0_B);
+   Gu32_CounterHigh=0;
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint32_t* pu32Count
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the 32 bit event count
+************************************************************************************/
+enuErrorStatus_t Counter_Read(uint32_t* pu32Count)
+{
+   uint8_t u8Sreg;
+   if (pu32Count == NULLPTR)
+   {
+      return ERROR;
+   }
+   //the count is spread over the ISR extension and TCNT0, read both with interrupts masked
+   ATOMIC_ENTER(u8Sreg);
+   *pu32Count=Counter_ReadRaw();
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint32_t u32Threshold, void(*pfCallback)(void)
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to call pfCallback (in interrupt context) when the count reaches u32Threshold,
+*              fails if the count has already passed the threshold
+************************************************************************************/
+enuErrorStatus_t Counter_SetThreshold(uint32_t u32Threshold, void(*pfCallback)(void))
+{
+   enuErrorStatus_t enuStatus=SUCCESS;
+   uint8_t u8Sreg;
+   if (pfCallback == NULLPTR)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   //a threshold that has already been reached can never fire
+   if (Counter_ReadRaw() >= u32Threshold)
+   {
+      enuStatus=ERROR;
+   }
+   else
+   {
+      Gu32_CounterThreshold=u32Threshold;
+      G_fptrCounterThreshold=pfCallback;
+      Gu8_CounterThrState=COUNTER_THR_WAITING;
+      //if the threshold is in the current block, arm the compare now, else the overflow hook will
+      if (Gu32_CounterHigh == (u32Threshold>>8))
+      {
+         Counter_ThresholdArm();
+      }
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return enuStatus;
+}
+
+/************************************************************************************
+* Parameters (in): uint16_t u16GateMs, void(*pfCallback)(void)
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (timer 2 taken by the kernel or the DDS)
+* Description: A function to start a frequency measurement over a gate of u16GateMs milliseconds,
+*              pfCallback (may be NULLPTR) is called in interrupt context when the result is ready
+************************************************************************************/
+enuErrorStatus_t Counter_FreqMeterStart(uint16_t u16GateMs, void(*pfCallback)(void))
+{
+   //timer 2 may belong to the kernel or the DDS in this build
+   if (u16GateMs == 0 || !COUNTER_FREQ_METER)
+   {
+      return ERROR;
+   }
+   //stop timer 2 and set up the gate
+   TCCR2_R=0;
+   Gu16_CounterGateMs=u16GateMs;
+   Gu16_CounterGateTicks=0;
+   Gu8_CounterFreqReady=0;
+   G_fptrCounterFreq=pfCallback;
+
+   //1 ms compare match in CTC mode
+   OCR2_R=COUNTER_GATE_OCR2;
+   TCNT2_R=0;
+   TIFR_R=(1<<OCF2_B);
+   Atomic_SetBits8(&TIMSK_R,(1<<OCIE2_B));
+   //start timer 2 in CTC mode with the gate prescaler
+   TCCR2_R=(1<<WGM21_B) | COUNTER_GATE_CS;
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint32_t* pu32FreqHz
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=result ready or 0=measurement still running
+* Description: A function to read the result of the last frequency measurement in Hz
+************************************************************************************/
+enuErrorStatus_t Counter_FreqMeterRead(uint32_t* pu32FreqHz)
+{
+   uint8_t u8Sreg;
+   if (pu32FreqHz == NULLPTR || Gu8_CounterFreqReady == 0)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   *pu32FreqHz=Gu32_CounterFreqHz;
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+
+/******************** Interrupt Handlers ****************************************/
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Timer 0 compare handler, runs when the count reaches the threshold low byte
+************************************************************************************/
+void Counter_OCHandler(void* pvCtx)
+{
+   //ignore a match that was already delivered while arming
+   if (Gu8_CounterThrState == COUNTER_THR_ARMED)
+   {
+      Counter_ThresholdFire();
+   }
+}
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Timer 2 compare handler, runs on every 1 ms gate tick of the frequency meter
+************************************************************************************/
+void Counter_GateHandler(void* pvCtx)
+{
+   uint32_t u32Count=Counter_ReadRaw();
+   uint32_t u32Events;
+   //the gate opens on the first tick so both ends see the same interrupt latency
+   if (Gu16_CounterGateTicks == 0)
+   {
+      Gu32_CounterGateStart=u32Count;
+   }
+   else if (Gu16_CounterGateTicks == Gu16_CounterGateMs)
+   {
+      //close the gate and stop timer 2
+      TCCR2_R=0;
+      CLR_BIT(TIMSK_R,OCIE2_B);
+      u32Events=u32Count-Gu32_CounterGateStart;
+      //events*1000/gate split up so it can not overflow 32 bits
+      Gu32_CounterFreqHz=(u32Events/Gu16_CounterGateMs)*1000UL
+                        +((u32Events%Gu16_CounterGateMs)*1000UL)/Gu16_CounterGateMs;
+      Gu8_CounterFreqReady=1;
+      if (G_fptrCounterFreq != NULLPTR)
+      {
+         G_fptrCounterFreq();
+      }
+      return;
+   }
+   Gu16_CounterGateTicks++;
+}
@@ -0,0 +1,141 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: Counter.h
+* Description: File containing function prototypes for Counter.c
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __EVENT_COUNTER__
+#define __EVENT_COUNTER__
+
+#include "DataTypes.h"
+#include "Utils.h"
+#include "Register.h"
+#include "Atomic.h"
+#include "Timer.h"
+
+/*
+ * Event counter on timer 0 clocked from the T0 pin (PB0).
+ * The 8 bit hardware count is extended to 32 bits in the overflow interrupt, so edges
+ * cost no CPU time except one interrupt every 256 events. The T0 input is synchronized
+ * to the CPU clock, so the highest countable frequency is about F_CPU/2.5.
+ * Timer 0 can not be used for delays (T0_Start) while the counter is running.
+ *
+ * The frequency meter gates the count with a timer 2 CTC window of whole milliseconds. In a
+ * build where timer 2 is the kernel tick (KERNEL_ENABLE) or the DDS carrier (DDS_ENABLE), or
+ * where F_CPU gives no exact 1 ms tick on timer 2 (e.g. 12 MHz), Counter_FreqMeterStart fails
+ * instead of reprogramming it or gating a wrong window.
+ */
+
+//timer 2 gate time base: the first prescaler (64, 32, 128, 8) giving an exact 1 ms tick in 8 bits,
+//the CS bits of timer 2 are 1:1, 8:2, 32:3, 64:4, 128:5
+#define COUNTER_GATE_FITS(p)        (((F_CPU/(p)) % 1000UL) == 0 && (F_CPU/(p)/1000UL) <= 256UL)
+#if   COUNTER_GATE_FITS(64UL)
+#define COUNTER_GATE_PRESCALER      64UL
+#define COUNTER_GATE_CS             4
+#elif COUNTER_GATE_FITS(32UL)
+#define COUNTER_GATE_PRESCALER      32UL
+#define COUNTER_GATE_CS             3
+#elif COUNTER_GATE_FITS(128UL)
+#define COUNTER_GATE_PRESCALER      128UL
+#define COUNTER_GATE_CS             5
+#elif COUNTER_GATE_FITS(8UL)
+#define COUNTER_GATE_PRESCALER      8UL
+#define COUNTER_GATE_CS             2
+#else
+//no exact gate, the frequency meter is left out
+#define COUNTER_GATE_PRESCALER      0UL
+#define COUNTER_GATE_CS             0
+#endif
+
+#if COUNTER_GATE_PRESCALER == 0 || defined(KERNEL_ENABLE) || defined(DDS_ENABLE)
+#define COUNTER_FREQ_METER          0
+#define COUNTER_GATE_OCR2           0
+#else
+#define COUNTER_FREQ_METER          1
+#define COUNTER_GATE_OCR2           ((F_CPU/COUNTER_GATE_PRESCALER/1000UL)-1)
+#endif
+
+typedef enum
+{
+   COUNTER_FALLING_EDGE,
+   COUNTER_RISING_EDGE
+
+}enuCounterEdge_t;
+
+/************************************************************************************
+* Parameters (in): enuCounterEdge_t enuEdge
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to initialize timer 0 as an event counter on the T0 pin and start counting
+************************************************************************************/
+enuErrorStatus_t Counter_Init(enuCounterEdge_t enuEdge);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop the event counter and release timer 0
+************************************************************************************/
+enuErrorStatus_t Counter_Stop(void);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to reset the event count to zero
+************************************************************************************/
+enuErrorStatus_t Counter_Clear(void);
+
+/************************************************************************************
+* Parameters (in): uint32_t* pu32Count
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the 32 bit event count
+************************************************************************************/
+enuErrorStatus_t Counter_Read(uint32_t* pu32Count);
+
+/************************************************************************************
+* Parameters (in): uint32_t u32Threshold, void(*pfCallback)(void)
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to call pfCallback (in interrupt context) when the count reaches u32Threshold,
+*              fails if the count has already passed the threshold
+************************************************************************************/
+enuErrorStatus_t Counter_SetThreshold(uint32_t u32Threshold, void(*pfCallback)(void));
+
+/************************************************************************************
+* Parameters (in): uint16_t u16GateMs, void(*pfCallback)(void)
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (timer 2 taken by the kernel or the DDS)
+* Description: A function to start a frequency measurement over a gate of u16GateMs milliseconds,
+*              pfCallback (may be NULLPTR) is called in interrupt context when the result is ready
+************************************************************************************/
+enuErrorStatus_t Counter_FreqMeterStart(uint16_t u16GateMs, void(*pfCallback)(void));
+
+/************************************************************************************
+* Parameters (in): uint32_t* pu32FreqHz
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=result ready or 0=measurement still running
+* Description: A function to read the result of the last frequency measurement in Hz
+************************************************************************************/
+enuErrorStatus_t Counter_FreqMeterRead(uint32_t* pu32FreqHz);
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Timer 0 compare handler, runs when the count reaches the threshold low byte
+************************************************************************************/
+void Counter_OCHandler(void* pvCtx);
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Timer 2 compare handler, runs on every 1 ms gate tick of the frequency meter
+************************************************************************************/
+void Counter_GateHandler(void* pvCtx);
+
+#endif /* __EVENT_COUNTER__ */
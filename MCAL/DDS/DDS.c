@@ -0,0 +1,179 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: DDS.c
+* Description: File containing the direct digital synthesis functions
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#include "DDS.h"
+
+#ifdef DDS_ENABLE
+
+//define DDS_BUILD_REPORT to print the ISR cycle budget while building
+#ifdef DDS_BUILD_REPORT
+#pragma message DDS_REPORT
+#endif
+
+#define DDS_OUTPUT_PIN     7        //PD7 / OC2
+#define DDS_MID_SCALE      128
+
+typedef struct
+{
+   uint32_t u32Phase;
+   uint32_t u32Tuning;
+   const __flash sint8_t* pas8Table;
+   uint8_t  u8Amplitude;
+}strDDSVoice_t;
+
+const __flash sint8_t Gas8_DDSSine[DDS_TABLE_SIZE] =
+{
+      0,   3,   6,   9,  12,  16,  19,  22,  25,  28,  31,  34,  37,  40,  43,  46,
+     49,  51,  54,  57,  60,  63,  65,  68,  71,  73,  76,  78,  81,  83,  85,  88,
+     90,  92,  94,  96,  98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+    117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+    127, 127, 127, 127, 126, 126, 126, 125, 125, 124, 123, 122, 122, 121, 120, 118,
+    117, 116, 115, 113, 112, 111, 109, 107, 106, 104, 102, 100,  98,  96,  94,  92,
+     90,  88,  85,  83,  81,  78,  76,  73,  71,  68,  65,  63,  60,  57,  54,  51,
+     49,  46,  43,  40,  37,  34,  31,  28,  25,  22,  19,  16,  12,   9,   6,   3,
+      0,  -3,  -6,  -9, -12, -16, -19, -22, -25, -28, -31, -34, -37, -40, -43, -46,
+    -49, -51, -54, -57, -60, -63, -65, -68, -71, -73, -76, -78, -81, -83, -85, -88,
+    -90, -92, -94, -96, -98,-100,-102,-104,-106,-107,-109,-111,-112,-113,-115,-116,
+   -117,-118,-120,-121,-122,-122,-123,-124,-125,-125,-126,-126,-126,-127,-127,-127,
+   -127,-127,-127,-127,-126,-126,-126,-125,-125,-124,-123,-122,-122,-121,-120,-118,
+   -117,-116,-115,-113,-112,-111,-109,-107,-106,-104,-102,-100, -98, -96, -94, -92,
+    -90, -88, -85, -83, -81, -78, -76, -73, -71, -68, -65, -63, -60, -57, -54, -51,
+    -49, -46, -43, -40, -37, -34, -31, -28, -25, -22, -19, -16, -12,  -9,  -6,  -3
+};
+
+strDDSVoice_t Gastr_DDSVoices[DDS_VOICES];
+//duty of the next carrier period, computed one period ahead
+volatile uint8_t Gu8_DDSNext=DDS_MID_SCALE;
+
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to start the carrier on OC2 (PD7) with every voice silent on the sine table
+************************************************************************************/
+enuErrorStatus_t DDS_Init(void)
+{
+   uint8_t u8Voice;
+   TCCR2_R=0;
+   Atomic_ClearBits8(&TIMSK_R,(1<<TOIE2_B));
+   for (u8Voice=0;u8Voice<DDS_VOICES;u8Voice++)
+   {
+      Gastr_DDSVoices[u8Voice].u32Phase=0;
+      Gastr_DDSVoices[u8Voice].u32Tuning=0;
+      Gastr_DDSVoices[u8Voice].pas8Table=Gas8_DDSSine;
+      Gastr_DDSVoices[u8Voice].u8Amplitude=0;
+   }
+   Gu8_DDSNext=DDS_MID_SCALE;
+   //timer 2 synchronous, fast PWM, non inverting OC2, clk/1
+   CLR_BIT(ASSR_R,AS2_B);
+   TCNT2_R=0;
+   OCR2_R=DDS_MID_SCALE;
+   SET_BIT(DDRD_R,DDS_OUTPUT_PIN);
+   TIFR_R=(1<<TOV2_B);
+   Atomic_SetBits8(&TIMSK_R,(1<<TOIE2_B));
+   TCCR2_R=(1<<WGM20_B) | (1<<WGM21_B) | (1<<COM21_B) | (1<<CS20_B);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop timer 2 and drive PD7 low
+************************************************************************************/
+enuErrorStatus_t DDS_Stop(void)
+{
+   TCCR2_R=0;
+   Atomic_ClearBits8(&TIMSK_R,(1<<TOIE2_B));
+   Atomic_ClearBits8(&PORTD_R,(1<<DDS_OUTPUT_PIN));
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Voice, uint32_t u32FreqMilliHz
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (voice or frequency out of range)
+* Description: A function to set the frequency of a voice in milli hertz, up to DDS_MAX_MILLIHZ,
+*              the phase goes on from where it is so the change has no step
+************************************************************************************/
+enuErrorStatus_t DDS_SetFrequency(uint8_t u8Voice, uint32_t u32FreqMilliHz)
+{
+   uint32_t u32Tuning;
+   uint8_t  u8Sreg;
+   if (u8Voice >= DDS_VOICES || u32FreqMilliHz > DDS_MAX_MILLIHZ)
+   {
+      return ERROR;
+   }
+   //f*2^32/rate, rounded, worked out here so the ISR only adds
+   u32Tuning=(uint32_t)((((uint64_t)u32FreqMilliHz<<32)+DDS_SAMPLE_RATE*500UL)/(DDS_SAMPLE_RATE*1000UL));
+   //the ISR reads the 4 bytes between two of its adds
+   ATOMIC_ENTER(u8Sreg);
+   Gastr_DDSVoices[u8Voice].u32Tuning=u32Tuning;
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Voice, uint8_t u8Amplitude
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set the amplitude of a voice, 0 silent to 255 full scale
+************************************************************************************/
+enuErrorStatus_t DDS_SetAmplitude(uint8_t u8Voice, uint8_t u8Amplitude)
+{
+   if (u8Voice >= DDS_VOICES)
+   {
+      return ERROR;
+   }
+   //one byte, no masking needed
+   Gastr_DDSVoices[u8Voice].u8Amplitude=u8Amplitude;
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Voice, const __flash sint8_t* pas8Table
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set the wavetable of a voice, DDS_TABLE_SIZE signed samples of one
+*              period in flash (NULLPTR for the sine)
+************************************************************************************/
+enuErrorStatus_t DDS_SetWave(uint8_t u8Voice, const __flash sint8_t* pas8Table)
+{
+   uint8_t u8Sreg;
+   if (u8Voice >= DDS_VOICES)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   Gastr_DDSVoices[u8Voice].pas8Table=(pas8Table != NULLPTR) ? pas8Table : Gas8_DDSSine;
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+
+/******************** Interrupt Handlers ****************************************/
+
+//carrier overflow: output the sample ready since the last period, then compute the next one
+ISR(TIMER2_OVF_vect)
+{
+   strDDSVoice_t* pstrVoice=Gastr_DDSVoices;
+   sint16_t s16Sum=0;
+   uint8_t  u8Voice;
+
+   OCR2_R=Gu8_DDSNext;
+   for (u8Voice=0;u8Voice<DDS_VOICES;u8Voice++,pstrVoice++)
+   {
+      pstrVoice->u32Phase+=pstrVoice->u32Tuning;
+      //signed sample times unsigned amplitude, the high byte is the scaled sample
+      s16Sum+=(sint16_t)(pstrVoice->pas8Table[(uint8_t)(pstrVoice->u32Phase>>24)]*(sint16_t)pstrVoice->u8Amplitude)>>8;
+   }
+   Gu8_DDSNext=(uint8_t)(DDS_MID_SCALE+(s16Sum>>DDS_MIX_SHIFT));
+}
+
+#endif /* DDS_ENABLE */
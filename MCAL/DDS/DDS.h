@@ -0,0 +1,117 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: DDS.h
+* Description: File containing function prototypes for DDS.c
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __DDS__
+#define __DDS__
+
+#include "DataTypes.h"
+#include "Utils.h"
+#include "Register.h"
+#include "Atomic.h"
+#include "Clock.h"
+
+/*
+ * Direct digital synthesis on timer 2, built with DDS_ENABLE defined.
+ * Timer 2 runs fast PWM at clk/1, the carrier is F_CPU/256 (31.25 kHz at 8 MHz, 62.5 kHz at
+ * 16 MHz) and its duty on OC2 (PD7) is the output sample, an RC low pass on the pin makes the
+ * analog signal. The overflow ISR (direct, not dispatched by Vect.c) writes the sample it
+ * computed on the previous overflow first, so the output has no jitter, then for every voice:
+ *    phase+=tuning                      32 bit accumulator, tuning=f*2^32/DDS_SAMPLE_RATE
+ *    s=table[phase>>24]*amplitude>>8    256 entry signed wavetable in flash
+ * and sums the voices into the next duty (128+sum>>DDS_MIX_SHIFT, no clipping possible).
+ * Frequency, amplitude and wavetable of each voice change at run time, a voice with
+ * amplitude 0 is silent but costs the same, so the ISR time is fixed.
+ *
+ * Cycle budget (instruction count estimate of the -Os ISR, not measured, no simulator in this
+ * tree): ~75 cycles of entry, register saves and mixing plus ~48 per voice. It has to end
+ * inside the 256 cycle carrier period whatever F_CPU is:
+ *    1 voice ~123 cycles (48% of the CPU), 2 voices ~171 (67%), 3 voices ~219 (86%)
+ * more than 3 voices do not fit. Define DDS_BUILD_REPORT to print the estimate while building.
+ *
+ * Timer 2 belongs to the DDS, the Counter frequency meter, Osc and the kernel tick can not be
+ * used with it.
+ */
+
+//configuration
+#define DDS_VOICES               2
+
+#define DDS_SAMPLE_RATE          (F_CPU/256UL)
+#define DDS_TABLE_SIZE           256
+#define DDS_ISR_CYCLES           (75UL+48UL*DDS_VOICES)
+#define DDS_CARRIER_CYCLES       256UL
+
+#if DDS_VOICES < 1 || DDS_ISR_CYCLES >= DDS_CARRIER_CYCLES
+#error "DDS: DDS_VOICES must be 1 to 3, more voices do not fit in the carrier period"
+#endif
+
+#if defined(DDS_ENABLE) && defined(KERNEL_ENABLE)
+#error "DDS: timer 2 can not be the DDS carrier and the kernel tick at the same time"
+#endif
+
+//the voices are summed and shifted right by this much so the sum fits in 8 bits
+#if DDS_VOICES == 1
+#define DDS_MIX_SHIFT            0
+#elif DDS_VOICES == 2
+#define DDS_MIX_SHIFT            1
+#else
+#define DDS_MIX_SHIFT            2
+#endif
+
+//highest frequency the output can carry (Nyquist)
+#define DDS_MAX_MILLIHZ          (DDS_SAMPLE_RATE*1000UL/2UL)
+
+#define DDS_STR(x)               #x
+#define DDS_XSTR(x)              DDS_STR(x)
+#define DDS_REPORT               "DDS: " DDS_XSTR(DDS_VOICES) " voices, ISR ~" DDS_XSTR(DDS_ISR_CYCLES) " of 256 cycles per sample"
+
+//sine, one period in DDS_TABLE_SIZE samples, -127 to 127
+extern const __flash sint8_t Gas8_DDSSine[DDS_TABLE_SIZE];
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to start the carrier on OC2 (PD7) with every voice silent on the sine table
+************************************************************************************/
+enuErrorStatus_t DDS_Init(void);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop timer 2 and drive PD7 low
+************************************************************************************/
+enuErrorStatus_t DDS_Stop(void);
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Voice, uint32_t u32FreqMilliHz
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (voice or frequency out of range)
+* Description: A function to set the frequency of a voice in milli hertz, up to DDS_MAX_MILLIHZ,
+*              the phase goes on from where it is so the change has no step
+************************************************************************************/
+enuErrorStatus_t DDS_SetFrequency(uint8_t u8Voice, uint32_t u32FreqMilliHz);
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Voice, uint8_t u8Amplitude
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set the amplitude of a voice, 0 silent to 255 full scale
+************************************************************************************/
+enuErrorStatus_t DDS_SetAmplitude(uint8_t u8Voice, uint8_t u8Amplitude);
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Voice, const __flash sint8_t* pas8Table
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set the wavetable of a voice, DDS_TABLE_SIZE signed samples of one
+*              period in flash (NULLPTR for the sine)
+************************************************************************************/
+enuErrorStatus_t DDS_SetWave(uint8_t u8Voice, const __flash sint8_t* pas8Table);
+
+#endif /* __DDS__ */
@@ -10,6 +10,9 @@
 #include "Utils.h"
 #include "DataTypes.h"
 #include "DIO.h"
+#include "Atomic.h"
+#include "Trace.h"
+#include "STimer.h"
 
 //Private macros used within the driver 
 #define DIO_PORT_NO  4u
@@ -22,6 +25,17 @@
 
 extern const enuDIOPinType_t DIOConfigParameters[DIO_MC_PINS];
 
+//deadline of a sleeping wait, wakes the CPU when the timeout runs out
+strSTimer_t Gstr_DIOWaitTimer;
+
+//level the pin has to show next, an edge is the level before it and then the other one
+typedef struct
+{
+   volatile uint8_t* pu8Pin;
+   uint8_t u8Mask;
+   uint8_t u8Want;            //0 or u8Mask
+}strDIOWait_t;
+
 /************************************************************************************
 * Parameters (in): void
 * Parameters (out): enuErrorStatus_t
@@ -32,6 +46,7 @@ enuErrorStatus_t DIO_Init(void)
 {
    uint8_t u8i;
    uint8_t u8port,u8pin;
+   uint8_t u8Sreg;
    //traverse the array of pins the user have used
    for (u8i=0;u8i<DIO_MC_PINS;u8i++)
    {
@@ -46,6 +61,9 @@ enuErrorStatus_t DIO_Init(void)
          return 0;
       }
       
+      //the bit number is a variable, so the read-modify-writes below are not single sbi/cbi and
+      //an ISR writing the same port in between would lose its update
+      ATOMIC_ENTER(u8Sreg);
       //decide which port are we working with
       switch (u8port)
       {
@@ -133,6 +151,7 @@ enuErrorStatus_t DIO_Init(void)
             }
          break;         
       }    
+      ATOMIC_EXIT(u8Sreg);
    }
    //return success status
    return SUCCESS;
@@ -149,6 +168,7 @@ enuErrorStatus_t DIO_Init(void)
 enuErrorStatus_t DIO_Write(enuDIOPinNo_t PinId, uint8_t u8Data)
 {
    uint8_t u8port,u8pin;
+   uint8_t u8Sreg;
    //calculate the port and pin number of the selected object
    u8port=PinId / DIO_PINS_NO;
    u8pin =PinId % DIO_PINS_NO;
@@ -162,6 +182,8 @@ enuErrorStatus_t DIO_Write(enuDIOPinNo_t PinId, uint8_t u8Data)
    
    else
    {
+      //the port may also be written from an ISR, see DIO_Init
+      ATOMIC_ENTER(u8Sreg);
       //select the calculated port 
       switch(u8port)
       {
@@ -209,6 +231,7 @@ enuErrorStatus_t DIO_Write(enuDIOPinNo_t PinId, uint8_t u8Data)
             }
          break;
       }
+      ATOMIC_EXIT(u8Sreg);
    }
    //return success status
    return SUCCESS;
@@ -272,6 +295,7 @@ enuErrorStatus_t DIO_Read(enuDIOPinNo_t PinId, uint8_t* pu8Data)
 enuErrorStatus_t DIO_Toggle(enuDIOPinNo_t PinId)
 {
    uint8_t u8port,u8pin;
+   uint8_t u8Sreg;
    //calculate the port and pin number of the selected object
    u8port=PinId / DIO_PINS_NO;
    u8pin =PinId % DIO_PINS_NO;
@@ -284,6 +308,9 @@ enuErrorStatus_t DIO_Toggle(enuDIOPinNo_t PinId)
    }
    else
    {
+      TRACE(TRACE_EV_DIO_TOGGLE,PinId);
+      //the port may also be written from an ISR, see DIO_Init
+      ATOMIC_ENTER(u8Sreg);
       //select the calculated port 
       switch(u8port)
       {
@@ -307,9 +334,153 @@ enuErrorStatus_t DIO_Toggle(enuDIOPinNo_t PinId)
             TOG_BIT(PORTD_R,u8pin);
          break;
       }
+      ATOMIC_EXIT(u8Sreg);
    }
    //return success status
    return SUCCESS;
 }
 
+/******************** Private Functions ****************************************/
+
+//the deadline timer only has to wake the CPU
+static void DIO_WaitWake(void* pvCtx)
+{
+   (void)pvCtx;
+}
+
+//find the PIN register and mask of an input pin
+static enuErrorStatus_t DIO_WaitPin(enuDIOPinNo_t PinId, strDIOWait_t* pstrWait)
+{
+   if (PinId >= DIO_MC_PINS || DIOConfigParameters[PinId] == OUTPUT)
+   {
+      return ERROR;
+   }
+   switch (PinId / DIO_PINS_NO)
+   {
+      case M_PORTA:  pstrWait->pu8Pin=&PINA_R;   break;
+      case M_PORTB:  pstrWait->pu8Pin=&PINB_R;   break;
+      case M_PORTC:  pstrWait->pu8Pin=&PINC_R;   break;
+      default:       pstrWait->pu8Pin=&PIND_R;   break;
+   }
+   pstrWait->u8Mask=(uint8_t)(1<<(PinId % DIO_PINS_NO));
+   return SUCCESS;
+}
+
+//sample the pin until it reads u8Want, u8Matches times for an edge (the level before it first)
+static enuErrorStatus_t DIO_Wait(strDIOWait_t* pstrWait, uint8_t u8Matches, enuDIOWaitMode_t enuMode,
+                                 uint32_t u32TimeoutUs, uint32_t* pu32Time)
+{
+   enuErrorStatus_t enuStatus=ERROR;
+   uint32_t u32Start;
+   uint32_t u32Ticks;
+   uint32_t u32Now;
+
+   if (u32TimeoutUs > STIMER_MAX_US || (enuMode == DIO_WAIT_SLEEP && GET_BIT(SREG_R,I_B) == 0))
+   {
+      return ERROR;
+   }
+   u32Ticks=STIMER_US_TO_TICKS(u32TimeoutUs);
+   u32Start=STimer_Now();
+   if (enuMode == DIO_WAIT_SLEEP)
+   {
+      if (STimer_Create(&Gstr_DIOWaitTimer,u32TimeoutUs,0,DIO_WaitWake,NULLPTR) == ERROR ||
+          STimer_Restart(&Gstr_DIOWaitTimer) == ERROR)
+      {
+         return ERROR;
+      }
+      //idle sleep, the timers and the UART keep running
+      MCUCR_R&=(uint8_t)~((1<<SM2_B) | (1<<SM1_B) | (1<<SM0_B));
+   }
+   while (1)
+   {
+      if (enuMode == DIO_WAIT_SLEEP)
+      {
+         cli();
+      }
+      u32Now=STimer_Now();
+      if ((*pstrWait->pu8Pin & pstrWait->u8Mask) == pstrWait->u8Want)
+      {
+         if (--u8Matches == 0)
+         {
+            enuStatus=SUCCESS;
+            break;
+         }
+         //the level before the edge was seen, now the other one
+         pstrWait->u8Want^=pstrWait->u8Mask;
+      }
+      if (u32Now-u32Start >= u32Ticks)
+      {
+         break;
+      }
+      if (enuMode == DIO_WAIT_SLEEP)
+      {
+         //sei takes effect after the next instruction, so a wake up between the sample and
+         //the sleep is not lost: its interrupt ends the sleep right away
+         SET_BIT(MCUCR_R,SE_B);
+         __asm__ __volatile__ ("sei \n\t" "sleep \n\t" ::: "memory");
+         CLR_BIT(MCUCR_R,SE_B);
+      }
+   }
+   if (enuMode == DIO_WAIT_SLEEP)
+   {
+      sei();
+      STimer_Stop(&Gstr_DIOWaitTimer);
+   }
+   if (enuStatus == SUCCESS && pu32Time != NULLPTR)
+   {
+      *pu32Time=u32Now;
+   }
+   return enuStatus;
+}
+
+
+/************************************************************************************
+* Parameters (in): enuDIOPinNo_t PinId, uint8_t u8Level, enuDIOWaitMode_t enuMode, uint32_t u32TimeoutUs,
+*                  uint32_t* pu32Time
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (timeout or invalid pin)
+* Description: A function to wait up to u32TimeoutUs (up to STIMER_MAX_US) for the input pin to read
+*              u8Level, pu32Time (may be NULLPTR) gets the time base tick it was seen at
+************************************************************************************/
+enuErrorStatus_t DIO_WaitLevel(enuDIOPinNo_t PinId, uint8_t u8Level, enuDIOWaitMode_t enuMode, uint32_t u32TimeoutUs,
+                               uint32_t* pu32Time)
+{
+   strDIOWait_t strWait;
+   if (DIO_WaitPin(PinId,&strWait) == ERROR)
+   {
+      return ERROR;
+   }
+   strWait.u8Want=u8Level ? strWait.u8Mask : 0;
+   return DIO_Wait(&strWait,1,enuMode,u32TimeoutUs,pu32Time);
+}
+
+/************************************************************************************
+* Parameters (in): enuDIOPinNo_t PinId, enuDIOEdge_t enuEdge, enuDIOWaitMode_t enuMode, uint32_t u32TimeoutUs,
+*                  uint32_t* pu32Time
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (timeout or invalid pin)
+* Description: A function to wait up to u32TimeoutUs (up to STIMER_MAX_US) for an edge of the input
+*              pin, pu32Time (may be NULLPTR) gets the time base tick of the first sample after it
+************************************************************************************/
+enuErrorStatus_t DIO_WaitEdge(enuDIOPinNo_t PinId, enuDIOEdge_t enuEdge, enuDIOWaitMode_t enuMode, uint32_t u32TimeoutUs,
+                              uint32_t* pu32Time)
+{
+   strDIOWait_t strWait;
+   if (DIO_WaitPin(PinId,&strWait) == ERROR || enuEdge > DIO_EDGE_ANY)
+   {
+      return ERROR;
+   }
+   if (enuEdge == DIO_EDGE_ANY)
+   {
+      //the level it starts at, then the other one
+      strWait.u8Want=*strWait.pu8Pin & strWait.u8Mask;
+   }
+   else
+   {
+      //the level before the edge, then the level after it
+      strWait.u8Want=(enuEdge == DIO_EDGE_RISING) ? 0 : strWait.u8Mask;
+   }
+   return DIO_Wait(&strWait,2,enuMode,u32TimeoutUs,pu32Time);
+}
+
 /**************************************************************************************************************/
@@ -20,6 +20,22 @@ typedef enum {PA0, PA1, PA2, PA3, PA4, PA5, PA6, PA7,
               PB0, PB1, PB2, PB3, PB4, PB5, PB6, PB7,
               PC0, PC1, PC2, PC3, PC4, PC5, PC6, PC7,
               PD0, PD1, PD2, PD3, PD4, PD5, PD6, PD7,ALL_PINS} enuDIOPinNo_t;
+typedef enum {DIO_EDGE_FALLING,DIO_EDGE_RISING,DIO_EDGE_ANY} enuDIOEdge_t;
+typedef enum {DIO_WAIT_SPIN,DIO_WAIT_SLEEP} enuDIOWaitMode_t;
+
+/*
+ * Bounded waits on an input pin.
+ * DIO_WaitLevel and DIO_WaitEdge read the PIN register directly (the port and mask are worked
+ * out once) and check the software timer time base (STimer_Now, STimer_Init has to be called)
+ * on every pass, ~40 cycles a sample at -Os, so a stuck input ends in a timeout instead of a
+ * hang. The time base tick of the sample that saw the level or edge is returned.
+ *
+ * DIO_WAIT_SLEEP puts the CPU in idle sleep between samples: any interrupt wakes it, the
+ * deadline is a one shot software timer so the timeout wakes it too. The pin is only seen when
+ * something wakes the CPU, so it should have an interrupt of its own (INT0-2 with the Encoder
+ * or a handler in Vect.c), the time stamp is then taken after that ISR ran. Interrupts have to
+ * be enabled for it.
+ */
 
 /************************************************************************************
 * Parameters (in): void
@@ -53,4 +69,26 @@ enuErrorStatus_t DIO_Read(enuDIOPinNo_t PinId, uint8_t* pu8Data);
 ************************************************************************************/
 enuErrorStatus_t DIO_Toggle(enuDIOPinNo_t PinId);
 
+/************************************************************************************
+* Parameters (in): enuDIOPinNo_t PinId, uint8_t u8Level, enuDIOWaitMode_t enuMode, uint32_t u32TimeoutUs,
+*                  uint32_t* pu32Time
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (timeout or invalid pin)
+* Description: A function to wait up to u32TimeoutUs (up to STIMER_MAX_US) for the input pin to read
+*              u8Level, pu32Time (may be NULLPTR) gets the time base tick it was seen at
+************************************************************************************/
+enuErrorStatus_t DIO_WaitLevel(enuDIOPinNo_t PinId, uint8_t u8Level, enuDIOWaitMode_t enuMode, uint32_t u32TimeoutUs,
+                               uint32_t* pu32Time);
+
+/************************************************************************************
+* Parameters (in): enuDIOPinNo_t PinId, enuDIOEdge_t enuEdge, enuDIOWaitMode_t enuMode, uint32_t u32TimeoutUs,
+*                  uint32_t* pu32Time
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (timeout or invalid pin)
+* Description: A function to wait up to u32TimeoutUs (up to STIMER_MAX_US) for an edge of the input
+*              pin, pu32Time (may be NULLPTR) gets the time base tick of the first sample after it
+************************************************************************************/
+enuErrorStatus_t DIO_WaitEdge(enuDIOPinNo_t PinId, enuDIOEdge_t enuEdge, enuDIOWaitMode_t enuMode, uint32_t u32TimeoutUs,
+                              uint32_t* pu32Time);
+
 #endif /* __DIO__ */
\ No newline at end of file
@@ -0,0 +1,196 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: EEPROM.c
+* Description: File containing the EEPROM driver functions
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#include "EEPROM.h"
+
+//write requests, the oldest at Gu8_EEPROMHead
+strEEPROMRequest_t Gastr_EEPROMQueue[EEPROM_QUEUE_SIZE];
+uint8_t Gu8_EEPROMHead=0;
+volatile uint8_t Gu8_EEPROMCount=0;
+
+
+/******************** Private Functions ****************************************/
+
+//EEMWE then EEWE within 4 cycles, sbi keeps them 2 cycles apart whatever the optimization
+static inline void EEPROM_Program(uint16_t u16Address, uint8_t u8Data)
+{
+   EEAR_R=u16Address;
+   EEDR_R=u8Data;
+   __asm__ __volatile__
+   (
+      "sbi  %[eecr],%[eemwe]        \n\t"
+      "sbi  %[eecr],%[eewe]         \n\t"
+      :: [eecr] "I" (EECR_IO), [eemwe] "I" (EEMWE_B), [eewe] "I" (EEWE_B)
+      : "memory"
+   );
+}
+
+//EEWE clear, the CPU halts 4 cycles for the read
+static inline uint8_t EEPROM_ReadByte(uint16_t u16Address)
+{
+   EEAR_R=u16Address;
+   EECR_R|=(1<<EERE_B);
+   return EEDR_R;
+}
+
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (a byte is being programmed)
+* Description: A function to empty the write queue
+************************************************************************************/
+enuErrorStatus_t EEPROM_Init(void)
+{
+   uint8_t u8Sreg;
+   enuErrorStatus_t enuStatus=SUCCESS;
+   ATOMIC_ENTER(u8Sreg);
+   if (GET_BIT(EECR_R,EEWE_B))
+   {
+      enuStatus=ERROR;
+   }
+   else
+   {
+      EECR_R&=(uint8_t)~(1<<EERIE_B);
+      Gu8_EEPROMHead=0;
+      Gu8_EEPROMCount=0;
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return enuStatus;
+}
+
+/************************************************************************************
+* Parameters (in): uint16_t u16Address, const uint8_t* pu8Data, uint16_t u16Length,
+*                  pfEEPROMDone_t pfDone, void* pvCtx
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (out of range or queue full)
+* Description: A function to queue writing u16Length bytes of pu8Data from u16Address, pfDone(pvCtx)
+*              (may be NULLPTR) runs in interrupt context when they are written, pu8Data has to
+*              stay unchanged until then
+************************************************************************************/
+enuErrorStatus_t EEPROM_Write(uint16_t u16Address, const uint8_t* pu8Data, uint16_t u16Length,
+                              pfEEPROMDone_t pfDone, void* pvCtx)
+{
+   enuErrorStatus_t enuStatus=ERROR;
+   uint8_t u8Sreg;
+   strEEPROMRequest_t* pstrRequest;
+   if (pu8Data == NULLPTR || u16Length == 0 || u16Address >= EEPROM_SIZE || u16Length > EEPROM_SIZE-u16Address)
+   {
+      return ERROR;
+   }
+   //a done callback may queue the next request, so the slot and the count are one section
+   ATOMIC_ENTER(u8Sreg);
+   if (Gu8_EEPROMCount < EEPROM_QUEUE_SIZE)
+   {
+      pstrRequest=&Gastr_EEPROMQueue[(Gu8_EEPROMHead+Gu8_EEPROMCount)%EEPROM_QUEUE_SIZE];
+      pstrRequest->pu8Data=pu8Data;
+      pstrRequest->u16Address=u16Address;
+      pstrRequest->u16Length=u16Length;
+      pstrRequest->u16Index=0;
+      pstrRequest->pfDone=pfDone;
+      pstrRequest->pvCtx=pvCtx;
+      Gu8_EEPROMCount++;
+      //the ready interrupt comes as soon as the EEPROM is free
+      EECR_R|=(1<<EERIE_B);
+      enuStatus=SUCCESS;
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return enuStatus;
+}
+
+/************************************************************************************
+* Parameters (in): uint16_t u16Address, uint8_t* pu8Data, uint16_t u16Length
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (out of range or writes pending)
+* Description: A function to read u16Length bytes from u16Address into pu8Data
+************************************************************************************/
+enuErrorStatus_t EEPROM_Read(uint16_t u16Address, uint8_t* pu8Data, uint16_t u16Length)
+{
+   uint8_t u8Sreg;
+   uint16_t u16Index;
+   if (pu8Data == NULLPTR || u16Address >= EEPROM_SIZE || u16Length > EEPROM_SIZE-u16Address)
+   {
+      return ERROR;
+   }
+   for (u16Index=0;u16Index<u16Length;u16Index++)
+   {
+      //a byte at a time so the interrupts wait ~10 cycles at most, an ISR may queue a write
+      //in between and EEAR must not change while a byte is programmed
+      ATOMIC_ENTER(u8Sreg);
+      if (Gu8_EEPROMCount || GET_BIT(EECR_R,EEWE_B))
+      {
+         ATOMIC_EXIT(u8Sreg);
+         return ERROR;
+      }
+      pu8Data[u16Index]=EEPROM_ReadByte(u16Address+u16Index);
+      ATOMIC_EXIT(u8Sreg);
+   }
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): uint8_t
+* Return value: 1 while writes are pending, else 0
+* Description: A function to check for pending writes
+************************************************************************************/
+uint8_t EEPROM_IsBusy(void)
+{
+   return Gu8_EEPROMCount != 0;
+}
+
+
+/******************** Interrupt Handlers ****************************************/
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: EEPROM ready handler, dispatched by Vect.c (see Vect_Cfg.c)
+************************************************************************************/
+void EEPROM_RDYHandler(void* pvCtx)
+{
+   strEEPROMRequest_t* pstrRequest;
+   uint8_t u8Skipped=0;
+   uint16_t u16Address;
+   uint8_t u8Data;
+   pfEEPROMDone_t pfDone;
+   (void)pvCtx;
+   while (Gu8_EEPROMCount)
+   {
+      pstrRequest=&Gastr_EEPROMQueue[Gu8_EEPROMHead];
+      while (pstrRequest->u16Index < pstrRequest->u16Length)
+      {
+         u16Address=pstrRequest->u16Address+pstrRequest->u16Index;
+         u8Data=pstrRequest->pu8Data[pstrRequest->u16Index];
+         pstrRequest->u16Index++;
+         if (EEPROM_ReadByte(u16Address) != u8Data)
+         {
+            //the next ready interrupt comes when this byte is written
+            EEPROM_Program(u16Address,u8Data);
+            return;
+         }
+         u8Skipped++;
+         if (u8Skipped >= EEPROM_SKIP_MAX)
+         {
+            //EERIE is still set, the interrupt comes back after the others had their turn
+            return;
+         }
+      }
+      //every byte is in, free the slot before the callback so it can queue the next request
+      pfDone=pstrRequest->pfDone;
+      pvCtx=pstrRequest->pvCtx;
+      Gu8_EEPROMHead=(Gu8_EEPROMHead+1)%EEPROM_QUEUE_SIZE;
+      Gu8_EEPROMCount--;
+      if (pfDone != NULLPTR)
+      {
+         pfDone(pvCtx);
+      }
+   }
+   EECR_R&=(uint8_t)~(1<<EERIE_B);
+}
@@ -0,0 +1,97 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: EEPROM.h
+* Description: File containing function prototypes for EEPROM.c
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __EEPROM__
+#define __EEPROM__
+
+#include "DataTypes.h"
+#include "Utils.h"
+#include "Register.h"
+#include "Atomic.h"
+
+/*
+ * Non blocking EEPROM writes.
+ * A byte takes ~8.5 ms to program, a write loop polling EEWE holds the CPU for all of it.
+ * EEPROM_Write only queues the request (up to EEPROM_QUEUE_SIZE of them) and returns, the
+ * EEPROM ready interrupt (dispatched by Vect.c) starts one byte at a time, so the CPU is busy
+ * for ~50 cycles per byte instead of ~68000 at 8 MHz and the other interrupts keep running.
+ * The ready interrupt fires while EEWE is clear and EERIE set, setting EERIE is enough to start.
+ *
+ * Before a byte is programmed the handler reads it (4 cycles), a byte that already holds the
+ * value is skipped and costs neither wear nor time. Up to EEPROM_SKIP_MAX skips are done in one
+ * interrupt, then the handler returns and the still enabled interrupt comes back at once, so a
+ * long unchanged block never holds the others off.
+ *
+ * The data is not copied, the buffer given to EEPROM_Write has to stay unchanged until its done
+ * callback, which runs in interrupt context once every byte is in the EEPROM. Requests are
+ * written in the order they were queued, EEPROM_Read fails while any is pending.
+ */
+
+//configuration
+#define EEPROM_QUEUE_SIZE        4
+#define EEPROM_SKIP_MAX          16          //unchanged bytes skipped in one interrupt
+
+#define EEPROM_SIZE              1024U
+
+typedef void (*pfEEPROMDone_t)(void* pvCtx);
+
+typedef struct
+{
+   const uint8_t* pu8Data;
+   uint16_t       u16Address;
+   uint16_t       u16Length;
+   uint16_t       u16Index;         //next byte to write
+   pfEEPROMDone_t pfDone;
+   void*          pvCtx;
+}strEEPROMRequest_t;
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (a byte is being programmed)
+* Description: A function to empty the write queue
+************************************************************************************/
+enuErrorStatus_t EEPROM_Init(void);
+
+/************************************************************************************
+* Parameters (in): uint16_t u16Address, const uint8_t* pu8Data, uint16_t u16Length,
+*                  pfEEPROMDone_t pfDone, void* pvCtx
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (out of range or queue full)
+* Description: A function to queue writing u16Length bytes of pu8Data from u16Address, pfDone(pvCtx)
+*              (may be NULLPTR) runs in interrupt context when they are written, pu8Data has to
+*              stay unchanged until then
+************************************************************************************/
+enuErrorStatus_t EEPROM_Write(uint16_t u16Address, const uint8_t* pu8Data, uint16_t u16Length,
+                              pfEEPROMDone_t pfDone, void* pvCtx);
+
+/************************************************************************************
+* Parameters (in): uint16_t u16Address, uint8_t* pu8Data, uint16_t u16Length
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (out of range or writes pending)
+* Description: A function to read u16Length bytes from u16Address into pu8Data
+************************************************************************************/
+enuErrorStatus_t EEPROM_Read(uint16_t u16Address, uint8_t* pu8Data, uint16_t u16Length);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): uint8_t
+* Return value: 1 while writes are pending, else 0
+* Description: A function to check for pending writes
+************************************************************************************/
+uint8_t EEPROM_IsBusy(void);
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: EEPROM ready handler, dispatched by Vect.c (see Vect_Cfg.c)
+************************************************************************************/
+void EEPROM_RDYHandler(void* pvCtx);
+
+#endif /* __EEPROM__ */
@@ -0,0 +1,404 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: Osc.c
+* Description: File containing the RC oscillator calibration functions
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#include "Osc.h"
+
+#define OSC_SPIN_MAX          2000     //polls without a timer 2 change before the crystal counts as stopped
+#define OSC_NO_SHIFT          0xFF
+#define OSC_TIMER1_CS_MASK    0x07
+#define OSC_SCALE_ONE         32768U   //1.0 in the Q15 correction scales
+#define OSC_ASYNC_BUSY        ((1<<TCN2UB_B) | (1<<OCR2UB_B) | (1<<TCR2UB_B))
+//time base ticks the runtime trim samples may be apart before timer 2 could have wrapped
+#define OSC_RETRIM_GAP_TICKS  STIMER_US_TO_TICKS(6500UL)
+
+//last measured clock, F_CPU until the first measurement
+uint32_t Gu32_OscClockHz=F_CPU;
+sint32_t Gs32_OscErrorPpm=0;
+uint8_t  Gu8_OscMeasured=0;
+//measured/F_CPU and F_CPU/measured in Q15
+volatile uint16_t Gu16_OscScale=OSC_SCALE_ONE;
+volatile uint16_t Gu16_OscInvScale=OSC_SCALE_ONE;
+
+//runtime trim, a window of samples runs from Gu32_OscRetrimStart
+strSTimer_t Gstr_OscRetrimTimer;
+uint32_t Gu32_OscRetrimStart=0;
+uint32_t Gu32_OscRetrimLast=0;
+uint16_t Gu16_OscRetrimRef=0;
+uint8_t  Gu8_OscRetrimLastRef=0;
+volatile uint8_t Gu8_OscRetrimRun=0;
+
+
+/******************** Private Functions ****************************************/
+
+//wait until timer 2 counted u8Ticks from u8From, fails if the count stops moving
+static enuErrorStatus_t Osc_WaitRef(uint8_t u8From, uint8_t u8Ticks)
+{
+   uint16_t u16Spins=0;
+   uint8_t  u8Last=u8From;
+   uint8_t  u8Now;
+   while ((uint8_t)((u8Now=TCNT2_R)-u8From) < u8Ticks)
+   {
+      if (u8Now != u8Last)
+      {
+         u8Last=u8Now;
+         u16Spins=0;
+      }
+      else if (++u16Spins == OSC_SPIN_MAX)
+      {
+         return ERROR;
+      }
+   }
+   return SUCCESS;
+}
+
+//timer 1 prescaler as a shift, OSC_NO_SHIFT if its ticks are too coarse to measure with
+static uint8_t Osc_Timer1Shift(void)
+{
+   switch (TCCR1B_R & OSC_TIMER1_CS_MASK)
+   {
+      case TIMER1_SCALER_1:   return 0;
+      case TIMER1_SCALER_8:   return 3;
+      default:                return OSC_NO_SHIFT;
+   }
+}
+
+//count the CPU clock over OSC_REF_TICKS crystal ticks, timer 1 must be running
+static enuErrorStatus_t Osc_Measure(uint8_t u8Shift, uint32_t* pu32Hz)
+{
+   enuErrorStatus_t enuStatus;
+   uint8_t  u8Sreg;
+   uint8_t  u8Ref;
+   uint16_t u16Start;
+   uint16_t u16End=0;
+   //both ends are read right after a timer 2 edge with interrupts masked, so the latency cancels
+   ATOMIC_ENTER(u8Sreg);
+   u8Ref=TCNT2_R;
+   enuStatus=Osc_WaitRef(u8Ref,1);
+   u16Start=TCNT1_R;
+   ATOMIC_EXIT(u8Sreg);
+   u8Ref++;
+   //timer 1 counts in hardware, the rest of the window can be interrupted
+   if (enuStatus == SUCCESS)
+   {
+      enuStatus=Osc_WaitRef(u8Ref,OSC_REF_TICKS-1);
+   }
+   if (enuStatus == SUCCESS)
+   {
+      ATOMIC_ENTER(u8Sreg);
+      //an interrupt that ran past the last edge leaves no edge to wait for
+      if ((uint8_t)(TCNT2_R-u8Ref) != OSC_REF_TICKS-1)
+      {
+         enuStatus=ERROR;
+      }
+      else
+      {
+         enuStatus=Osc_WaitRef(u8Ref,OSC_REF_TICKS);
+         u16End=TCNT1_R;
+      }
+      ATOMIC_EXIT(u8Sreg);
+   }
+   //the 16 bit difference holds the window at up to 2x F_CPU
+   *pu32Hz=((uint32_t)(uint16_t)(u16End-u16Start)<<u8Shift)<<OSC_REF_SHIFT;
+   return enuStatus;
+}
+
+//measure with a few tries, an interrupt longer than a crystal tick spoils a window
+static enuErrorStatus_t Osc_MeasureRetry(uint8_t u8Shift, uint32_t* pu32Hz)
+{
+   uint8_t u8Try;
+   for (u8Try=0;u8Try<3;u8Try++)
+   {
+      if (Osc_Measure(u8Shift,pu32Hz) == SUCCESS)
+      {
+         return SUCCESS;
+      }
+   }
+   return ERROR;
+}
+
+static uint32_t Osc_Distance(uint32_t u32Hz)
+{
+   return (u32Hz > F_CPU) ? (u32Hz-F_CPU) : (F_CPU-u32Hz);
+}
+
+//store a measured clock and the correction scales, must be called with interrupts disabled
+static void Osc_Update(uint32_t u32Hz)
+{
+   sint32_t s32Ppm=((sint32_t)u32Hz-(sint32_t)F_CPU)/(sint32_t)CLOCK_MHZ;
+   uint16_t u16Scale;
+   if (s32Ppm > OSC_PPM_LIMIT)
+   {
+      s32Ppm=OSC_PPM_LIMIT;
+   }
+   else if (s32Ppm < -OSC_PPM_LIMIT)
+   {
+      s32Ppm=-OSC_PPM_LIMIT;
+   }
+   //32768/1000000 reduced to 4096/125000 so the product fits 32 bits
+   u16Scale=(uint16_t)(OSC_SCALE_ONE+(s32Ppm*4096L)/125000L);
+   Gu32_OscClockHz=u32Hz;
+   Gs32_OscErrorPpm=s32Ppm;
+   Gu16_OscScale=u16Scale;
+   Gu16_OscInvScale=(uint16_t)((1UL<<30)/u16Scale);
+   Gu8_OscMeasured=1;
+}
+
+//scale a count by a Q15 factor without 64 bit math
+static uint32_t Osc_Scale(uint32_t u32Count, uint16_t u16Scale)
+{
+   return (u32Count>>15)*u16Scale+(((u32Count & 0x7FFF)*u16Scale)>>15);
+}
+
+//runtime trim sample, called from the software timer interrupt
+static void Osc_RetrimSample(void* pvCtx)
+{
+   uint32_t u32Now=STimer_Now();
+   uint8_t  u8Ref=TCNT2_R;
+   uint32_t u32Cycles;
+   uint32_t u32Hz;
+   //the first sample or one too late to tell the timer 2 wraps apart starts a window
+   if (Gu8_OscRetrimRun == 0 || u32Now-Gu32_OscRetrimLast > OSC_RETRIM_GAP_TICKS)
+   {
+      Gu32_OscRetrimStart=u32Now;
+      Gu16_OscRetrimRef=0;
+      Gu8_OscRetrimRun=1;
+   }
+   else
+   {
+      Gu16_OscRetrimRef+=(uint8_t)(u8Ref-Gu8_OscRetrimLastRef);
+   }
+   Gu32_OscRetrimLast=u32Now;
+   Gu8_OscRetrimLastRef=u8Ref;
+   if (Gu16_OscRetrimRef < OSC_RETRIM_REF_TICKS)
+   {
+      return;
+   }
+
+   //the window is ~1 s, cycles*32768/ticks split so it can not overflow 32 bits
+   u32Cycles=(u32Now-Gu32_OscRetrimStart)*STIMER_PRESCALER;
+   u32Hz=(u32Cycles/Gu16_OscRetrimRef)*OSC_REF_HZ+((u32Cycles%Gu16_OscRetrimRef)*OSC_REF_HZ)/Gu16_OscRetrimRef;
+   Osc_Update(u32Hz);
+   //one step at a time, the frequency rises with OSCCAL
+   if (Gs32_OscErrorPpm > OSC_RETRIM_PPM && OSCCAL_R > 0)
+   {
+      OSCCAL_R--;
+   }
+   else if (Gs32_OscErrorPpm < -OSC_RETRIM_PPM && OSCCAL_R < 0xFF)
+   {
+      OSCCAL_R++;
+   }
+   Gu32_OscRetrimStart=u32Now;
+   Gu16_OscRetrimRef=0;
+}
+
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (the crystal does not run)
+* Description: A function to start timer 2 asynchronously from the 32768 Hz crystal as the reference
+************************************************************************************/
+enuErrorStatus_t Osc_Init(void)
+{
+   uint16_t u16Spins=0;
+   //timer 2 may belong to the kernel or the DDS in this build
+   if (!OSC_TIMER2_FREE)
+   {
+      return ERROR;
+   }
+   //no timer 2 interrupt may run while its clock source changes
+   Atomic_ClearBits8(&TIMSK_R,(1<<OCIE2_B) | (1<<TOIE2_B));
+   ASSR_R=(1<<AS2_B);
+   //normal mode without prescaler, one count per crystal tick
+   TCNT2_R=0;
+   OCR2_R=0;
+   TCCR2_R=(1<<CS20_B);
+   //the writes take two crystal ticks to reach the asynchronous timer
+   while (ASSR_R & OSC_ASYNC_BUSY)
+   {
+      if (++u16Spins == OSC_SPIN_MAX)
+      {
+         return ERROR;
+      }
+   }
+   TIFR_R=(1<<OCF2_B) | (1<<TOV2_B);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to search the OSCCAL value that brings the CPU clock closest to F_CPU,
+*              blocks for ~20 ms, fails if the crystal stops or timer 1 runs at a prescaler above 8,
+*              OSCCAL keeps its entry value on a failure
+************************************************************************************/
+enuErrorStatus_t Osc_Calibrate(void)
+{
+   enuErrorStatus_t enuStatus=SUCCESS;
+   uint8_t  u8Sreg;
+   uint8_t  u8Shift;
+   uint8_t  u8Started=0;
+   uint8_t  u8Oscal;
+   uint16_t u16Low=0;
+   uint16_t u16High=0xFF;
+   uint16_t u16Mid;
+   uint32_t u32Hz=0;
+   uint32_t u32BestHz=0;
+
+   if (!OSC_TIMER2_FREE)
+   {
+      return ERROR;
+   }
+   //the search moves the clock, a failed one puts the entry value back
+   u8Oscal=OSCCAL_R;
+   //use timer 1 as it runs, or run it at prescaler 1 for the search
+   if ((TCCR1B_R & OSC_TIMER1_CS_MASK) == TIMER1_STOP)
+   {
+      Atomic_SetBits8(&TCCR1B_R,TIMER1_SCALER_1);
+      u8Started=1;
+   }
+   u8Shift=Osc_Timer1Shift();
+   if (u8Shift == OSC_NO_SHIFT)
+   {
+      //skip the search, timer 1 is still put back below
+      enuStatus=ERROR;
+   }
+
+   //find the lowest OSCCAL running at F_CPU or faster
+   while (u16Low < u16High && enuStatus == SUCCESS)
+   {
+      u16Mid=(u16Low+u16High)>>1;
+      OSCCAL_R=(uint8_t)u16Mid;
+      enuStatus=Osc_MeasureRetry(u8Shift,&u32Hz);
+      if (u32Hz < F_CPU)
+      {
+         u16Low=u16Mid+1;
+      }
+      else
+      {
+         u16High=u16Mid;
+      }
+   }
+   //it or the one below it is the closest
+   if (enuStatus == SUCCESS)
+   {
+      OSCCAL_R=(uint8_t)u16Low;
+      enuStatus=Osc_MeasureRetry(u8Shift,&u32BestHz);
+   }
+   if (enuStatus == SUCCESS && u16Low > 0)
+   {
+      OSCCAL_R=(uint8_t)(u16Low-1);
+      enuStatus=Osc_MeasureRetry(u8Shift,&u32Hz);
+      if (Osc_Distance(u32Hz) < Osc_Distance(u32BestHz))
+      {
+         u32BestHz=u32Hz;
+      }
+      else
+      {
+         OSCCAL_R=(uint8_t)u16Low;
+      }
+   }
+
+   if (u8Started)
+   {
+      Atomic_ClearBits8(&TCCR1B_R,OSC_TIMER1_CS_MASK);
+   }
+   if (enuStatus == ERROR)
+   {
+      OSCCAL_R=u8Oscal;
+   }
+   if (enuStatus == SUCCESS)
+   {
+      ATOMIC_ENTER(u8Sreg);
+      Osc_Update(u32BestHz);
+      //a runtime trim window that saw the search is thrown away
+      Gu8_OscRetrimRun=0;
+      ATOMIC_EXIT(u8Sreg);
+   }
+   return enuStatus;
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to start trimming OSCCAL at runtime from a periodic software timer,
+*              STimer_Init has to be called first
+************************************************************************************/
+enuErrorStatus_t Osc_RetrimStart(void)
+{
+   if (!OSC_TIMER2_FREE)
+   {
+      return ERROR;
+   }
+   Osc_RetrimStop();
+   Gu8_OscRetrimRun=0;
+   if (STimer_Create(&Gstr_OscRetrimTimer,OSC_RETRIM_PERIOD_US,OSC_RETRIM_PERIOD_US,Osc_RetrimSample,NULLPTR) == ERROR)
+   {
+      return ERROR;
+   }
+   //the samples are read when they run, a late one costs nothing
+   STimer_SetSlack(&Gstr_OscRetrimTimer,OSC_RETRIM_SLACK_US);
+   STimer_SetOverrunPolicy(&Gstr_OscRetrimTimer,STIMER_OVERRUN_SKIP);
+   return STimer_Restart(&Gstr_OscRetrimTimer);
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop the runtime trim, OSCCAL keeps its value
+************************************************************************************/
+enuErrorStatus_t Osc_RetrimStop(void)
+{
+   return STimer_Stop(&Gstr_OscRetrimTimer);
+}
+
+/************************************************************************************
+* Parameters (in): uint32_t* pu32ClockHz, sint32_t* ps32ErrorPpm
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (not measured yet)
+* Description: A function to read the last measured CPU clock and its error from F_CPU in ppm
+************************************************************************************/
+enuErrorStatus_t Osc_GetClock(uint32_t* pu32ClockHz, sint32_t* ps32ErrorPpm)
+{
+   uint8_t u8Sreg;
+   if (pu32ClockHz == NULLPTR || ps32ErrorPpm == NULLPTR || Gu8_OscMeasured == 0)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   *pu32ClockHz=Gu32_OscClockHz;
+   *ps32ErrorPpm=Gs32_OscErrorPpm;
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint32_t u32Count
+* Parameters (out): uint32_t
+* Return value: the count at the measured clock
+* Description: A function to scale a cycle or tick count computed from F_CPU to the measured clock,
+*              u32Count is returned as it is until the clock is measured
+************************************************************************************/
+uint32_t Osc_NominalToActual(uint32_t u32Count)
+{
+   return Osc_Scale(u32Count,Atomic_Read16(&Gu16_OscScale));
+}
+
+/************************************************************************************
+* Parameters (in): uint32_t u32Count
+* Parameters (out): uint32_t
+* Return value: the count at F_CPU
+* Description: A function to scale a cycle or tick count of the measured clock back to F_CPU
+************************************************************************************/
+uint32_t Osc_ActualToNominal(uint32_t u32Count)
+{
+   return Osc_Scale(u32Count,Atomic_Read16(&Gu16_OscInvScale));
+}
@@ -0,0 +1,132 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: Osc.h
+* Description: File containing function prototypes for Osc.c
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __OSC__
+#define __OSC__
+
+#include "DataTypes.h"
+#include "Utils.h"
+#include "Register.h"
+#include "Atomic.h"
+#include "Clock.h"
+#include "STimer.h"
+
+/*
+ * Internal RC oscillator calibration against a 32768 Hz watch crystal on TOSC1/TOSC2 (PC6/PC7).
+ * Timer 2 runs asynchronously from the crystal and is the reference, the CPU clock is counted
+ * with timer 1 between timer 2 ticks:
+ *    Osc_Calibrate     binary searches OSCCAL for the value closest to F_CPU (blocking, ~10
+ *                      measurements of OSC_REF_TICKS crystal ticks, ~20 ms), the interrupts are
+ *                      only masked around the two timer 2 edges of each measurement
+ *    Osc_RetrimStart   keeps the clock trimmed at runtime without blocking: a periodic software
+ *                      timer samples timer 2 and the time base, once OSC_RETRIM_REF_TICKS crystal
+ *                      ticks (1 s) are collected the clock is measured and OSCCAL moved by one
+ *                      step if it is off by more than OSC_RETRIM_PPM
+ *
+ * The measured clock (Osc_GetClock) is what the last measurement found, an OSCCAL step only
+ * shows in the next one. The timers compute their counts from F_CPU at compile time, with
+ * OSC_TIMER_CORRECTION defined T0_Start and the software timers scale the counts by the
+ * measured clock (OSC_CORRECT in Clock.h), which takes out the error left after the last
+ * OSCCAL step.
+ *
+ * Timer 2 belongs to this driver after Osc_Init, so the frequency meter gate (Counter) can
+ * not be used with it. In a build where timer 2 is the kernel tick (KERNEL_ENABLE) or the DDS
+ * carrier (DDS_ENABLE) Osc_Init, Osc_Calibrate and Osc_RetrimStart fail instead of touching
+ * it. Timer 1 is used as it is found when it runs at prescaler 1 or 8 (the software timers),
+ * a stopped timer 1 runs at prescaler 1 during Osc_Calibrate.
+ * The crystal needs about 1 s after power up to settle before Osc_Calibrate, and no EEPROM
+ * or flash write may run during the search, the clock moves far from F_CPU while it runs.
+ * The RC oscillator is only specified at 1, 2, 4 and 8 MHz, at other clocks the search ends on
+ * the closest OSCCAL it can reach.
+ */
+
+#if defined(KERNEL_ENABLE) || defined(DDS_ENABLE)
+#define OSC_TIMER2_FREE          0
+#else
+#define OSC_TIMER2_FREE          1
+#endif
+
+//configuration
+#define OSC_REF_HZ               32768UL
+#define OSC_REF_TICKS            64          //crystal ticks per calibration measurement (~2 ms)
+#define OSC_REF_SHIFT            9           //OSC_REF_HZ/OSC_REF_TICKS as a shift
+#define OSC_RETRIM_PERIOD_US     5000UL      //sampling period of the runtime trim
+#define OSC_RETRIM_SLACK_US      1000UL      //the sampling may share an interrupt with other timers
+#define OSC_RETRIM_REF_TICKS     32768U      //crystal ticks per runtime measurement (1 s)
+#define OSC_RETRIM_PPM           5000L       //error the runtime trim leaves alone (about one step)
+#define OSC_PPM_LIMIT            250000L     //largest error the correction scales by
+
+//timer 2 wraps every 256 crystal ticks (7.8 ms), the samples have to be closer than that
+#if (OSC_RETRIM_PERIOD_US+OSC_RETRIM_SLACK_US) > 7000UL
+#error "Osc: the runtime trim has to sample timer 2 before it wraps"
+#endif
+#if (OSC_REF_HZ/OSC_REF_TICKS) != (1UL<<OSC_REF_SHIFT)
+#error "Osc: OSC_REF_SHIFT does not match OSC_REF_TICKS"
+#endif
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (the crystal does not run)
+* Description: A function to start timer 2 asynchronously from the 32768 Hz crystal as the reference
+************************************************************************************/
+enuErrorStatus_t Osc_Init(void);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to search the OSCCAL value that brings the CPU clock closest to F_CPU,
+*              blocks for ~20 ms, fails if the crystal stops or timer 1 runs at a prescaler above 8,
+*              OSCCAL keeps its entry value on a failure
+************************************************************************************/
+enuErrorStatus_t Osc_Calibrate(void);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to start trimming OSCCAL at runtime from a periodic software timer,
+*              STimer_Init has to be called first
+************************************************************************************/
+enuErrorStatus_t Osc_RetrimStart(void);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop the runtime trim, OSCCAL keeps its value
+************************************************************************************/
+enuErrorStatus_t Osc_RetrimStop(void);
+
+/************************************************************************************
+* Parameters (in): uint32_t* pu32ClockHz, sint32_t* ps32ErrorPpm
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (not measured yet)
+* Description: A function to read the last measured CPU clock and its error from F_CPU in ppm
+************************************************************************************/
+enuErrorStatus_t Osc_GetClock(uint32_t* pu32ClockHz, sint32_t* ps32ErrorPpm);
+
+/************************************************************************************
+* Parameters (in): uint32_t u32Count
+* Parameters (out): uint32_t
+* Return value: the count at the measured clock
+* Description: A function to scale a cycle or tick count computed from F_CPU to the measured clock,
+*              u32Count is returned as it is until the clock is measured
+************************************************************************************/
+uint32_t Osc_NominalToActual(uint32_t u32Count);
+
+/************************************************************************************
+* Parameters (in): uint32_t u32Count
+* Parameters (out): uint32_t
+* Return value: the count at F_CPU
+* Description: A function to scale a cycle or tick count of the measured clock back to F_CPU
+************************************************************************************/
+uint32_t Osc_ActualToNominal(uint32_t u32Count);
+
+#endif /* __OSC__ */
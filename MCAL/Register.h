@@ -9,7 +9,10 @@
 #ifndef __REGISTER__
 #define __REGISTER__
 
+//default board clock, a build for another board passes -DF_CPU (see Clock.h)
+#ifndef F_CPU
 #define  F_CPU    8000000UL
+#endif
 
 /* DIO_Registers */
 #define DDRA_R  (*(volatile unsigned char*)0x3A)
@@ -28,6 +31,12 @@
 #define PORTD_R (*(volatile unsigned char*)0x32)
 /************************************************************************************************/
 
+/* Status Register */
+#define SREG_R  (*(volatile unsigned char*)0x5F)
+/* SREG */
+#define I_B       7
+/************************************************************************************************/
+
 
 /************************************************************************************************/
 /* Timer 0 */
@@ -89,12 +98,22 @@
 #define TCCR1A_R     (*(volatile unsigned char*)0x4F)
 #define SFIOR_R		(*(volatile unsigned char*)0x50)
 #define OSCCAL_R		(*(volatile unsigned char*)0x51)
+
+/* SFIOR */
+#define ADTS2_B   7
+#define ADTS1_B   6
+#define ADTS0_B   5
+#define ACME_B    3
+#define PUD_B     2
+#define PSR2_B    1
+#define PSR10_B   0
 /*************************************************************************************************/
 /* Timer 2 */
 
 #define OCR2_R       (*(volatile unsigned char*)0x43)
 #define TCNT2_R      (*(volatile unsigned char*)0x44)
 #define TCCR2_R      (*(volatile unsigned char*)0x45)
+#define ASSR_R       (*(volatile unsigned char*)0x42)
 
 
 
@@ -137,6 +156,158 @@
 #define CS10_B    0
 
 
+/*************************************************************************************************/
+/* TWI */
+
+#define TWBR_R       (*(volatile unsigned char*)0x20)
+#define TWSR_R       (*(volatile unsigned char*)0x21)
+#define TWAR_R       (*(volatile unsigned char*)0x22)
+#define TWDR_R       (*(volatile unsigned char*)0x23)
+//I/O space addresses for in/out in assembly (memory address - 0x20)
+#define TWBR_IO      0x00
+#define TWAR_IO      0x02
+#define EECR_IO      0x1C
+#define TCCR2_IO     0x25
+#define TCCR1B_IO    0x2E
+#define SFIOR_IO     0x30
+#define TCCR0_IO     0x33
+#define SPL_IO       0x3D
+#define SPH_IO       0x3E
+#define SREG_IO      0x3F
+
+
+/*************************************************************************************************/
+/* ADC */
+
+#define ADC_R        (*(volatile unsigned short*)0x24)
+#define ADCL_R       (*(volatile unsigned char*)0x24)
+#define ADCH_R       (*(volatile unsigned char*)0x25)
+#define ADCSRA_R     (*(volatile unsigned char*)0x26)
+#define ADMUX_R      (*(volatile unsigned char*)0x27)
+
+/* ADMUX */
+#define REFS1_B   7
+#define REFS0_B   6
+#define ADLAR_B   5
+
+/* ADCSRA */
+#define ADEN_B    7
+#define ADSC_B    6
+#define ADATE_B   5
+#define ADIF_B    4
+#define ADIE_B    3
+#define ADPS2_B   2
+#define ADPS1_B   1
+#define ADPS0_B   0
+
+/*************************************************************************************************/
+/* EEPROM */
+
+#define EEAR_R       (*(volatile unsigned short*)0x3E)
+#define EEDR_R       (*(volatile unsigned char*)0x3D)
+#define EECR_R       (*(volatile unsigned char*)0x3C)
+
+/* EECR */
+/* bits 7-4 reserved */
+#define EERIE_B   3
+#define EEMWE_B   2
+#define EEWE_B    1
+#define EERE_B    0
+
+/*************************************************************************************************/
+/* SPI */
+
+#define SPCR_R       (*(volatile unsigned char*)0x2D)
+#define SPSR_R       (*(volatile unsigned char*)0x2E)
+#define SPDR_R       (*(volatile unsigned char*)0x2F)
+
+/* SPCR */
+#define SPIE_B    7
+#define SPE_B     6
+#define DORD_B    5
+#define MSTR_B    4
+#define CPOL_B    3
+#define CPHA_B    2
+#define SPR1_B    1
+#define SPR0_B    0
+
+/* SPSR */
+#define SPIF_B    7
+#define WCOL_B    6
+#define SPI2X_B   0
+
+/*************************************************************************************************/
+/* UART */
+
+#define UBRRL_R      (*(volatile unsigned char*)0x29)
+#define UCSRB_R      (*(volatile unsigned char*)0x2A)
+#define UCSRA_R      (*(volatile unsigned char*)0x2B)
+#define UDR_R        (*(volatile unsigned char*)0x2C)
+/* UBRRH and UCSRC share one address, URSEL selects UCSRC on writes */
+#define UBRRH_R      (*(volatile unsigned char*)0x40)
+#define UCSRC_R      (*(volatile unsigned char*)0x40)
+
+/* UCSRA */
+#define RXC_B     7
+#define TXC_B     6
+#define UDRE_B    5
+#define FE_B      4
+#define DOR_B     3
+#define PE_B      2
+#define U2X_B     1
+#define MPCM_B    0
+
+/* UCSRB */
+#define RXCIE_B   7
+#define TXCIE_B   6
+#define UDRIE_B   5
+#define RXEN_B    4
+#define TXEN_B    3
+#define UCSZ2_B   2
+#define RXB8_B    1
+#define TXB8_B    0
+
+/* UCSRC */
+#define URSEL_B   7
+#define UMSEL_B   6
+#define UPM1_B    5
+#define UPM0_B    4
+#define USBS_B    3
+#define UCSZ1_B   2
+#define UCSZ0_B   1
+#define UCPOL_B   0
+
+/*************************************************************************************************/
+/* External Interrupts */
+
+#define MCUCR_R      (*(volatile unsigned char*)0x55)
+#define MCUCSR_R     (*(volatile unsigned char*)0x54)
+#define GIFR_R       (*(volatile unsigned char*)0x5A)
+#define GICR_R       (*(volatile unsigned char*)0x5B)
+
+/* MCUCR */
+#define SE_B      7
+#define SM2_B     6
+#define SM1_B     5
+#define SM0_B     4
+#define ISC11_B   3
+#define ISC10_B   2
+#define ISC01_B   1
+#define ISC00_B   0
+
+/* MCUCSR */
+#define ISC2_B    6
+
+/* GICR */
+#define INT1_B    7
+#define INT0_B    6
+#define INT2_B    5
+
+/* GIFR */
+#define INTF1_B   7
+#define INTF0_B   6
+#define INTF2_B   5
+
 /*************************************************************************************************/
 
 /* Interrupt vectors */
@@ -185,8 +356,8 @@
 
 /*interrupt functions*/
 
-# define sei()  __asm__ __volatile__ ("sei" ::)
-# define cli()  __asm__ __volatile__ ("cli" ::)
+# define sei()  __asm__ __volatile__ ("sei" ::: "memory")
+# define cli()  __asm__ __volatile__ ("cli" ::: "memory")
 # define reti()  __asm__ __volatile__ ("reti" ::)
 # define ret()  __asm__ __volatile__ ("ret" ::)
 
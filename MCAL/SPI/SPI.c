@@ -0,0 +1,134 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: SPI.c
+* Description: File containing the SPI driver functions
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#include "SPI.h"
+
+//running transfer
+const uint8_t*   Gpu8_SPITx=NULLPTR;
+uint8_t*         Gpu8_SPIRx=NULLPTR;
+uint8_t          Gu8_SPILength=0;
+uint8_t          Gu8_SPIIndex=0;
+pfSPIDone_t      G_fptrSPIDone=NULLPTR;
+void*            Gpv_SPIDoneCtx=NULLPTR;
+volatile uint8_t Gu8_SPIBusy=0;
+
+
+/************************************************************************************
+* Parameters (in): enuSPIClock_t enuClock, enuSPIMode_t enuMode, enuSPIOrder_t enuOrder
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set up the SPI as master with the selected clock divider, mode and bit order
+************************************************************************************/
+enuErrorStatus_t SPI_Init(enuSPIClock_t enuClock, enuSPIMode_t enuMode, enuSPIOrder_t enuOrder)
+{
+   uint8_t u8Spcr;
+   if (enuClock > SPI_CLOCK_DIV128 || enuMode > SPI_MODE3 || enuOrder > SPI_LSB_FIRST)
+   {
+      return ERROR;
+   }
+   //SS output before MSTR, an input SS pulled low would turn the SPI into a slave
+   Atomic_SetBits8(&DDRB_R,(1<<SPI_SS_PIN) | (1<<SPI_MOSI_PIN) | (1<<SPI_SCK_PIN));
+   Atomic_ClearBits8(&DDRB_R,(1<<SPI_MISO_PIN));
+   u8Spcr=(1<<SPIE_B) | (1<<SPE_B) | (1<<MSTR_B) | ((uint8_t)enuMode<<CPHA_B);
+   if (enuOrder == SPI_LSB_FIRST)
+   {
+      u8Spcr|=(1<<DORD_B);
+   }
+   //dividers 2, 8, 32 are 4, 16, 64 at double speed, 128 has no double speed twin
+   switch (enuClock)
+   {
+      case SPI_CLOCK_DIV2:    SPSR_R=(1<<SPI2X_B);                                  break;
+      case SPI_CLOCK_DIV4:    SPSR_R=0;                                             break;
+      case SPI_CLOCK_DIV8:    SPSR_R=(1<<SPI2X_B);  u8Spcr|=(1<<SPR0_B);             break;
+      case SPI_CLOCK_DIV16:   SPSR_R=0;             u8Spcr|=(1<<SPR0_B);             break;
+      case SPI_CLOCK_DIV32:   SPSR_R=(1<<SPI2X_B);  u8Spcr|=(1<<SPR1_B);             break;
+      case SPI_CLOCK_DIV64:   SPSR_R=0;             u8Spcr|=(1<<SPR1_B);             break;
+      default:                SPSR_R=0;             u8Spcr|=(1<<SPR1_B) | (1<<SPR0_B); break;
+   }
+   SPCR_R=u8Spcr;
+   Gu8_SPIBusy=0;
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): const uint8_t* pu8Tx, uint8_t* pu8Rx, uint8_t u8Length, pfSPIDone_t pfDone, void* pvCtx
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (a transfer is running)
+* Description: A function to start sending u8Length bytes of pu8Tx, the bytes received go to pu8Rx
+*              (may be NULLPTR), pfDone(pvCtx) (may be NULLPTR) runs in interrupt context at the end,
+*              both buffers have to stay valid until then
+************************************************************************************/
+enuErrorStatus_t SPI_Transfer(const uint8_t* pu8Tx, uint8_t* pu8Rx, uint8_t u8Length, pfSPIDone_t pfDone, void* pvCtx)
+{
+   enuErrorStatus_t enuStatus=ERROR;
+   uint8_t u8Sreg;
+   if (pu8Tx == NULLPTR || u8Length == 0)
+   {
+      return ERROR;
+   }
+   //the done callback may start the next transfer, so the busy test and the start are one section
+   ATOMIC_ENTER(u8Sreg);
+   if (!Gu8_SPIBusy)
+   {
+      Gpu8_SPITx=pu8Tx;
+      Gpu8_SPIRx=pu8Rx;
+      Gu8_SPILength=u8Length;
+      Gu8_SPIIndex=0;
+      G_fptrSPIDone=pfDone;
+      Gpv_SPIDoneCtx=pvCtx;
+      Gu8_SPIBusy=1;
+      SPDR_R=pu8Tx[0];
+      enuStatus=SUCCESS;
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return enuStatus;
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): uint8_t
+* Return value: 1 while a transfer is running, else 0
+* Description: A function to check for a running transfer
+************************************************************************************/
+uint8_t SPI_IsBusy(void)
+{
+   return Gu8_SPIBusy;
+}
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Transfer complete handler, dispatched by Vect.c (see Vect_Cfg.c)
+************************************************************************************/
+void SPI_STCHandler(void* pvCtx)
+{
+   uint8_t u8Data=SPDR_R;
+   (void)pvCtx;
+   if (!Gu8_SPIBusy)
+   {
+      return;
+   }
+   if (Gpu8_SPIRx != NULLPTR)
+   {
+      Gpu8_SPIRx[Gu8_SPIIndex]=u8Data;
+   }
+   Gu8_SPIIndex++;
+   if (Gu8_SPIIndex < Gu8_SPILength)
+   {
+      SPDR_R=Gpu8_SPITx[Gu8_SPIIndex];
+   }
+   else
+   {
+      Gu8_SPIBusy=0;
+      if (G_fptrSPIDone != NULLPTR)
+      {
+         G_fptrSPIDone(Gpv_SPIDoneCtx);
+      }
+   }
+}
@@ -0,0 +1,95 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: SPI.h
+* Description: File containing function prototypes for SPI.c
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __SPI__
+#define __SPI__
+
+#include "DataTypes.h"
+#include "Utils.h"
+#include "Register.h"
+#include "Atomic.h"
+
+/*
+ * Interrupt driven SPI master on MOSI (PB5), MISO (PB6), SCK (PB7).
+ * SPI_Transfer starts a buffer in the background: the transfer complete interrupt stores the
+ * received byte and writes the next one, and calls the done callback (interrupt context) after
+ * the last. A byte costs the dispatched ISR, ~60 cycles, plus its 16 to 256 clock cycles on the
+ * wire. SS (PB4) is made an output so the SPI stays master, drivers use it as a chip select or
+ * a latch line.
+ */
+
+#define SPI_SS_PIN         4     //PB4
+#define SPI_MOSI_PIN       5     //PB5
+#define SPI_MISO_PIN       6     //PB6
+#define SPI_SCK_PIN        7     //PB7
+
+typedef enum
+{
+   SPI_CLOCK_DIV2=0,
+   SPI_CLOCK_DIV4,
+   SPI_CLOCK_DIV8,
+   SPI_CLOCK_DIV16,
+   SPI_CLOCK_DIV32,
+   SPI_CLOCK_DIV64,
+   SPI_CLOCK_DIV128
+
+}enuSPIClock_t;
+
+typedef enum
+{
+   SPI_MODE0=0,               //CPOL=0 CPHA=0
+   SPI_MODE1,                 //CPOL=0 CPHA=1
+   SPI_MODE2,                 //CPOL=1 CPHA=0
+   SPI_MODE3                  //CPOL=1 CPHA=1
+
+}enuSPIMode_t;
+
+typedef enum
+{
+   SPI_MSB_FIRST=0,
+   SPI_LSB_FIRST
+
+}enuSPIOrder_t;
+
+typedef void (*pfSPIDone_t)(void* pvCtx);
+
+/************************************************************************************
+* Parameters (in): enuSPIClock_t enuClock, enuSPIMode_t enuMode, enuSPIOrder_t enuOrder
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set up the SPI as master with the selected clock divider, mode and bit order
+************************************************************************************/
+enuErrorStatus_t SPI_Init(enuSPIClock_t enuClock, enuSPIMode_t enuMode, enuSPIOrder_t enuOrder);
+
+/************************************************************************************
+* Parameters (in): const uint8_t* pu8Tx, uint8_t* pu8Rx, uint8_t u8Length, pfSPIDone_t pfDone, void* pvCtx
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (a transfer is running)
+* Description: A function to start sending u8Length bytes of pu8Tx, the bytes received go to pu8Rx
+*              (may be NULLPTR), pfDone(pvCtx) (may be NULLPTR) runs in interrupt context at the end,
+*              both buffers have to stay valid until then
+************************************************************************************/
+enuErrorStatus_t SPI_Transfer(const uint8_t* pu8Tx, uint8_t* pu8Rx, uint8_t u8Length, pfSPIDone_t pfDone, void* pvCtx);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): uint8_t
+* Return value: 1 while a transfer is running, else 0
+* Description: A function to check for a running transfer
+************************************************************************************/
+uint8_t SPI_IsBusy(void);
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Transfer complete handler, dispatched by Vect.c (see Vect_Cfg.c)
+************************************************************************************/
+void SPI_STCHandler(void* pvCtx);
+
+#endif /* __SPI__ */
@@ -0,0 +1,576 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: STimer.c
+* Description: File containing the software timer functions
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#include "STimer.h"
+#include "Trace.h"
+
+#define STIMER_HALF_RANGE     0x8000
+//cycles between reading the time base and the compare being set, a closer deadline is moved out
+#define STIMER_LEAD_CYCLES    64UL
+#define STIMER_LEAD_TICKS     ((STIMER_LEAD_CYCLES+STIMER_PRESCALER-1)/STIMER_PRESCALER)
+
+//upper 16 bits of the time base, counted by the timer 1 overflow
+volatile uint16_t Gu16_STimerHigh=0;
+//all timers that are running or were stopped since the last interrupt
+strSTimer_t* Gpstr_STimerList=NULLPTR;
+//deadline the compare is set for
+uint32_t Gu32_STimerNext=0;
+uint8_t  Gu8_STimerArmed=0;
+strSTimerStats_t Gstr_STimerStats={0,0,0,0,0};
+pfSTimerOverrunHook_t G_fptrSTimerOverrunHook=NULLPTR;
+
+
+/******************** Private Functions ****************************************/
+
+//read the 32 bit time base, must be called with interrupts disabled
+static uint32_t STimer_NowRaw(void)
+{
+   uint16_t u16High=Gu16_STimerHigh;
+   uint16_t u16Low=TCNT1_R;
+   //if an overflow is pending that the ISR has not counted yet and the low word was read after it
+   if (GET_BIT(TIFR_R,TOV1_B) && u16Low < STIMER_HALF_RANGE)
+   {
+      u16High++;
+   }
+   return ((uint32_t)u16High<<16) | u16Low;
+}
+
+//set the compare on a deadline, must be called with interrupts disabled
+static void STimer_Arm(uint32_t u32Deadline)
+{
+   uint32_t u32Now=STimer_NowRaw();
+   Gu32_STimerNext=u32Deadline;
+   Gu8_STimerArmed=1;
+   //a deadline that is too close (or passed) could be missed by the compare, fire it right after
+   if ((sint32_t)(u32Deadline-u32Now) < (sint32_t)STIMER_LEAD_TICKS)
+   {
+      u32Deadline=u32Now+STIMER_LEAD_TICKS;
+   }
+   //only the low word fits the compare, a deadline further away fires early and is set again
+   OCR1A_R=(uint16_t)u32Deadline;
+   TIFR_R=(1<<OCF1A_B);
+   SET_BIT(TIMSK_R,OCIE1A_B);
+}
+
+//set the compare on the earliest latest-allowed expiry of the running timers, must be called with
+//interrupts disabled
+static void STimer_Program(void)
+{
+   strSTimer_t* pstrTimer;
+   uint32_t u32Next=0;
+   uint32_t u32Latest;
+   uint8_t  u8Found=0;
+   for (pstrTimer=Gpstr_STimerList;pstrTimer!=NULLPTR;pstrTimer=pstrTimer->pstrNext)
+   {
+      u32Latest=pstrTimer->u32Deadline+pstrTimer->u32Slack;
+      if (pstrTimer->u8Active && (!u8Found || (sint32_t)(u32Latest-u32Next) < 0))
+      {
+         u32Next=u32Latest;
+         u8Found=1;
+      }
+   }
+   if (u8Found)
+   {
+      STimer_Arm(u32Next);
+   }
+   else
+   {
+      //nothing to wait for
+      Gu8_STimerArmed=0;
+      CLR_BIT(TIMSK_R,OCIE1A_B);
+   }
+}
+
+//count the periods a periodic timer missed and apply its policy, the start of the next period
+//plus the slack (u32Deadline+u32Slack) has already passed, called from the interrupt
+static void STimer_Overrun(strSTimer_t* pstrTimer, uint32_t u32Now)
+{
+   //the division only runs on an overrun, a period is missed once its slack is used up too
+   uint32_t u32Missed=(u32Now-pstrTimer->u32Deadline-pstrTimer->u32Slack)/pstrTimer->u32Period+1;
+   if (u32Missed > 0xFFFF)
+   {
+      u32Missed=0xFFFF;
+   }
+   if (pstrTimer->enuOverrun == STIMER_OVERRUN_SKIP)
+   {
+      //start the next period now
+      pstrTimer->u32Deadline=u32Now+pstrTimer->u32Period;
+   }
+   else
+   {
+      //keep the phase, move to the first period that has not started yet
+      pstrTimer->u32Deadline+=u32Missed*pstrTimer->u32Period;
+   }
+   pstrTimer->u16Missed=(uint16_t)u32Missed;
+   if (pstrTimer->u16MissedTotal > 0xFFFF-(uint16_t)u32Missed)
+   {
+      pstrTimer->u16MissedTotal=0xFFFF;
+   }
+   else
+   {
+      pstrTimer->u16MissedTotal+=(uint16_t)u32Missed;
+   }
+   Gstr_STimerStats.u32Missed+=u32Missed;
+}
+
+//check if a timer is in the list, must be called with interrupts disabled
+static uint8_t STimer_IsLinked(const strSTimer_t* pstrTimer)
+{
+   const strSTimer_t* pstrItem;
+   for (pstrItem=Gpstr_STimerList;pstrItem!=NULLPTR;pstrItem=pstrItem->pstrNext)
+   {
+      if (pstrItem == pstrTimer)
+      {
+         return 1;
+      }
+   }
+   return 0;
+}
+
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to start timer 1 as the free running time base of the software timers
+************************************************************************************/
+enuErrorStatus_t STimer_Init(void)
+{
+   uint8_t u8Sreg;
+   ATOMIC_ENTER(u8Sreg);
+   //stop timer 1 and reset the time base
+   Timer1_Init(TIMER1_NORMAL_MODE,TIMER1_STOP);
+   TCNT1_R=0;
+   Gu16_STimerHigh=0;
+   Gstr_STimerStats.u32Interrupts=0;
+   Gstr_STimerStats.u32Empty=0;
+   Gstr_STimerStats.u32Expirations=0;
+   Gstr_STimerStats.u32Saved=0;
+   Gstr_STimerStats.u32Missed=0;
+   TIFR_R=(1<<TOV1_B) | (1<<OCF1A_B);
+   //extend the count on every overflow, the compare is enabled when a timer runs
+   SET_BIT(TIMSK_R,TOIE1_B);
+   Timer1_Init(TIMER1_NORMAL_MODE,STIMER_SCALER);
+   //running timers are due relative to the old time base, set the compare on them again
+   STimer_Program();
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): strSTimer_t* pstrTimer, uint32_t u32TimeoutUs, uint32_t u32PeriodUs,
+*                  pfSTimerCallback_t pfCallback, void* pvCtx
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set up a timer that calls pfCallback(pvCtx) in interrupt context
+*              u32TimeoutUs after each restart and then every u32PeriodUs (0 for a one shot timer),
+*              both times can not exceed STIMER_MAX_US and the timer must not be running
+************************************************************************************/
+enuErrorStatus_t STimer_Create(strSTimer_t* pstrTimer, uint32_t u32TimeoutUs, uint32_t u32PeriodUs,
+                               pfSTimerCallback_t pfCallback, void* pvCtx)
+{
+   enuErrorStatus_t enuStatus=SUCCESS;
+   uint8_t u8Sreg;
+   if (pstrTimer == NULLPTR || pfCallback == NULLPTR || u32TimeoutUs > STIMER_MAX_US || u32PeriodUs > STIMER_MAX_US)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   //the handle may be new (any content) or a stopped timer still in the list
+   if (STimer_IsLinked(pstrTimer) && pstrTimer->u8Active)
+   {
+      enuStatus=ERROR;
+   }
+   else
+   {
+      pstrTimer->u8Active=0;
+      pstrTimer->u8Due=0;
+      pstrTimer->pfCallback=pfCallback;
+      pstrTimer->pvCtx=pvCtx;
+      pstrTimer->u32Timeout=OSC_CORRECT(STIMER_US_TO_TICKS(u32TimeoutUs));
+      pstrTimer->u32Period=OSC_CORRECT(STIMER_US_TO_TICKS(u32PeriodUs));
+      pstrTimer->u32Slack=0;
+      pstrTimer->u16Missed=0;
+      pstrTimer->u16MissedTotal=0;
+      pstrTimer->enuOverrun=STIMER_OVERRUN_ONCE;
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return enuStatus;
+}
+
+/************************************************************************************
+* Parameters (in): strSTimer_t* pstrTimer
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to start the timer, or start it over if it is running, with the timeout
+*              given to STimer_Create
+************************************************************************************/
+enuErrorStatus_t STimer_Restart(strSTimer_t* pstrTimer)
+{
+   uint8_t u8Sreg;
+   uint32_t u32Deadline;
+   if (pstrTimer == NULLPTR)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   u32Deadline=STimer_NowRaw()+pstrTimer->u32Timeout;
+   pstrTimer->u32Deadline=u32Deadline;
+   //a running timer is in the list already, only a stopped one has to be looked up
+   if (!pstrTimer->u8Active && !STimer_IsLinked(pstrTimer))
+   {
+      pstrTimer->pstrNext=Gpstr_STimerList;
+      Gpstr_STimerList=pstrTimer;
+   }
+   pstrTimer->u8Active=1;
+   TRACE(TRACE_EV_TIMER_START,TRACE_HANDLE(pstrTimer));
+   //an expiry collected by the interrupt but not delivered yet belongs to the old start
+   pstrTimer->u8Due=0;
+   //move the compare only if this timer is now the first that can not wait
+   u32Deadline+=pstrTimer->u32Slack;
+   if (!Gu8_STimerArmed || (sint32_t)(u32Deadline-Gu32_STimerNext) < 0)
+   {
+      STimer_Arm(u32Deadline);
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): strSTimer_t* pstrTimer, uint32_t u32SlackUs
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to let the timer run up to u32SlackUs late so it can share an interrupt
+*              with other timers (0 after STimer_Create), used from the next restart or expiry,
+*              the timeout and the period of the timer plus u32SlackUs can not exceed STIMER_MAX_US
+************************************************************************************/
+enuErrorStatus_t STimer_SetSlack(strSTimer_t* pstrTimer, uint32_t u32SlackUs)
+{
+   uint8_t  u8Sreg;
+   uint32_t u32Longest;
+   if (pstrTimer == NULLPTR || u32SlackUs > STIMER_MAX_US)
+   {
+      return ERROR;
+   }
+   //deadline+slack has to stay within half the time base from now, else the signed comparisons
+   //take it for a time that has passed
+   u32Longest=(pstrTimer->u32Timeout > pstrTimer->u32Period) ? pstrTimer->u32Timeout : pstrTimer->u32Period;
+   if (u32Longest > STIMER_MAX_TICKS || STIMER_US_TO_TICKS(u32SlackUs) > STIMER_MAX_TICKS-u32Longest)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   pstrTimer->u32Slack=STIMER_US_TO_TICKS(u32SlackUs);
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): strSTimer_t* pstrTimer, enuSTimerOverrun_t enuOverrun
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to select what a periodic timer does with missed periods
+*              (STIMER_OVERRUN_ONCE after STimer_Create)
+************************************************************************************/
+enuErrorStatus_t STimer_SetOverrunPolicy(strSTimer_t* pstrTimer, enuSTimerOverrun_t enuOverrun)
+{
+   if (pstrTimer == NULLPTR || enuOverrun > STIMER_OVERRUN_CATCHUP)
+   {
+      return ERROR;
+   }
+   pstrTimer->enuOverrun=enuOverrun;
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): strSTimer_t* pstrTimer, uint16_t* pu16Missed, uint16_t* pu16MissedTotal
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the periods missed before the current (called from the callback)
+*              or last expiry, and since STimer_Create
+************************************************************************************/
+enuErrorStatus_t STimer_GetOverrun(strSTimer_t* pstrTimer, uint16_t* pu16Missed, uint16_t* pu16MissedTotal)
+{
+   uint8_t u8Sreg;
+   if (pstrTimer == NULLPTR || pu16Missed == NULLPTR || pu16MissedTotal == NULLPTR)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   *pu16Missed=pstrTimer->u16Missed;
+   *pu16MissedTotal=pstrTimer->u16MissedTotal;
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): pfSTimerOverrunHook_t pfHook
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set the function called in interrupt context with the timer and the
+*              number of missed periods whenever a periodic timer overruns (NULLPTR for none)
+************************************************************************************/
+enuErrorStatus_t STimer_SetOverrunHook(pfSTimerOverrunHook_t pfHook)
+{
+   uint8_t u8Sreg;
+   ATOMIC_ENTER(u8Sreg);
+   G_fptrSTimerOverrunHook=pfHook;
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): strSTimer_t* pstrTimer
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop the timer, its callback is not called after this returns
+************************************************************************************/
+enuErrorStatus_t STimer_Stop(strSTimer_t* pstrTimer)
+{
+   if (pstrTimer == NULLPTR)
+   {
+      return ERROR;
+   }
+   //byte stores, the interrupt drops the timer from the list the next time it runs and an
+   //expiry it collected but did not deliver yet is dropped too
+   pstrTimer->u8Active=0;
+   pstrTimer->u8Due=0;
+   TRACE(TRACE_EV_TIMER_STOP,TRACE_HANDLE(pstrTimer));
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): strSTimer_t* pstrTimer, uint32_t u32DeltaUs
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (timer not running or too far)
+* Description: A function to move the next expiry of a running timer u32DeltaUs later, the time
+*              left to the expiry plus u32DeltaUs and the slack can not exceed STIMER_MAX_US
+************************************************************************************/
+enuErrorStatus_t STimer_Extend(strSTimer_t* pstrTimer, uint32_t u32DeltaUs)
+{
+   enuErrorStatus_t enuStatus=SUCCESS;
+   uint8_t  u8Sreg;
+   uint32_t u32Delta;
+   uint32_t u32Left;
+   if (pstrTimer == NULLPTR || u32DeltaUs > STIMER_MAX_US)
+   {
+      return ERROR;
+   }
+   u32Delta=OSC_CORRECT(STIMER_US_TO_TICKS(u32DeltaUs));
+   ATOMIC_ENTER(u8Sreg);
+   if (pstrTimer->u8Active)
+   {
+      //ticks to the deadline, none if it has passed
+      u32Left=pstrTimer->u32Deadline-STimer_NowRaw();
+      if ((sint32_t)u32Left < 0)
+      {
+         u32Left=0;
+      }
+      //as in STimer_SetSlack the new deadline+slack has to stay within half the time base from
+      //now, else the signed comparisons take it for a time that has passed and it fires at once
+      if (u32Left > STIMER_MAX_TICKS || pstrTimer->u32Slack > STIMER_MAX_TICKS-u32Left
+          || u32Delta > STIMER_MAX_TICKS-u32Left-pstrTimer->u32Slack)
+      {
+         enuStatus=ERROR;
+      }
+      else
+      {
+         //a later deadline never needs the compare moved
+         pstrTimer->u32Deadline+=u32Delta;
+      }
+   }
+   else
+   {
+      enuStatus=ERROR;
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return enuStatus;
+}
+
+/************************************************************************************
+* Parameters (in): strSTimer_t* pstrTimer, uint32_t* pu32RemainingUs
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (timer not running)
+* Description: A function to read the time left until the next expiry in micro seconds
+************************************************************************************/
+enuErrorStatus_t STimer_Remaining(strSTimer_t* pstrTimer, uint32_t* pu32RemainingUs)
+{
+   enuErrorStatus_t enuStatus=SUCCESS;
+   uint8_t  u8Sreg;
+   sint32_t s32Left=0;
+   if (pstrTimer == NULLPTR || pu32RemainingUs == NULLPTR)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   if (pstrTimer->u8Active)
+   {
+      s32Left=(sint32_t)(pstrTimer->u32Deadline-STimer_NowRaw());
+   }
+   else
+   {
+      enuStatus=ERROR;
+   }
+   ATOMIC_EXIT(u8Sreg);
+   //a deadline that passed but was not handled yet has no time left
+   if (s32Left < 0)
+   {
+      s32Left=0;
+   }
+   *pu32RemainingUs=STIMER_TICKS_TO_US(OSC_UNCORRECT((uint32_t)s32Left));
+   return enuStatus;
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): uint32_t
+* Return value: the 32 bit tick count of the time base
+* Description: A function to read the time base, STIMER_TICKS_PER_US ticks per micro second
+************************************************************************************/
+uint32_t STimer_Now(void)
+{
+   uint8_t  u8Sreg;
+   uint32_t u32Now;
+   ATOMIC_ENTER(u8Sreg);
+   u32Now=STimer_NowRaw();
+   ATOMIC_EXIT(u8Sreg);
+   return u32Now;
+}
+
+/************************************************************************************
+* Parameters (in): strSTimerStats_t* pstrStats
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the interrupt and coalescing statistics since STimer_Init
+************************************************************************************/
+enuErrorStatus_t STimer_GetStats(strSTimerStats_t* pstrStats)
+{
+   uint8_t u8Sreg;
+   if (pstrStats == NULLPTR)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   *pstrStats=Gstr_STimerStats;
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+
+/******************** Interrupt Handlers ****************************************/
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Timer 1 overflow handler, extends the time base, dispatched by Vect.c
+************************************************************************************/
+void STimer_OVFHandler(void* pvCtx)
+{
+   Gu16_STimerHigh++;
+}
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Timer 1 compare A handler, calls the due timers, dispatched by Vect.c
+************************************************************************************/
+void STimer_CompareHandler(void* pvCtx)
+{
+   strSTimer_t* pstrPrev=NULLPTR;
+   strSTimer_t* pstrTimer=Gpstr_STimerList;
+   strSTimer_t* pstrNext;
+   uint8_t  u8DueNo=0;
+   uint8_t  u8Calls;
+   uint32_t u32Now=STimer_NowRaw();
+
+   //first pass: drop the stopped timers and collect the due ones, the list is not changed by
+   //callbacks while it is walked
+   while (pstrTimer != NULLPTR)
+   {
+      pstrNext=pstrTimer->pstrNext;
+      if (!pstrTimer->u8Active)
+      {
+         if (pstrPrev == NULLPTR)
+         {
+            Gpstr_STimerList=pstrNext;
+         }
+         else
+         {
+            pstrPrev->pstrNext=pstrNext;
+         }
+      }
+      else
+      {
+         if ((sint32_t)(u32Now-pstrTimer->u32Deadline) >= 0)
+         {
+            pstrTimer->u8Due=1;
+            u8DueNo++;
+            //periodic timers keep their phase, one shot timers stop
+            if (pstrTimer->u32Period != 0)
+            {
+               pstrTimer->u32Deadline+=pstrTimer->u32Period;
+               pstrTimer->u16Missed=0;
+               //the next period and its slack have passed already, the timer overran (a slack
+               //of a period or more is not an overrun while the timer is within it)
+               if ((sint32_t)(u32Now-pstrTimer->u32Deadline-pstrTimer->u32Slack) >= 0)
+               {
+                  STimer_Overrun(pstrTimer,u32Now);
+               }
+            }
+            else
+            {
+               pstrTimer->u8Active=0;
+            }
+         }
+         pstrPrev=pstrTimer;
+      }
+      pstrTimer=pstrNext;
+   }
+
+   //every timer after the first one due in this interrupt would have needed its own
+   Gstr_STimerStats.u32Interrupts++;
+   if (u8DueNo == 0)
+   {
+      Gstr_STimerStats.u32Empty++;
+   }
+   else
+   {
+      Gstr_STimerStats.u32Expirations+=u8DueNo;
+      Gstr_STimerStats.u32Saved+=u8DueNo-1;
+   }
+
+   //second pass: call the due timers, callbacks may restart or stop any timer and only add
+   //new ones at the head of the list
+   for (pstrTimer=Gpstr_STimerList;pstrTimer!=NULLPTR;pstrTimer=pstrTimer->pstrNext)
+   {
+      //the overrun hook may stop the timer, which drops its expiry
+      if (pstrTimer->u8Due && pstrTimer->u16Missed != 0 && G_fptrSTimerOverrunHook != NULLPTR)
+      {
+         G_fptrSTimerOverrunHook(pstrTimer,pstrTimer->u16Missed);
+      }
+      if (pstrTimer->u8Due)
+      {
+         pstrTimer->u8Due=0;
+         u8Calls=1;
+         //a catch up timer gets the missed periods back to back
+         if (pstrTimer->enuOverrun == STIMER_OVERRUN_CATCHUP)
+         {
+            u8Calls+=(pstrTimer->u16Missed < STIMER_CATCHUP_MAX) ? (uint8_t)pstrTimer->u16Missed : STIMER_CATCHUP_MAX;
+         }
+         do
+         {
+            TRACE(TRACE_EV_CALLBACK,TRACE_HANDLE(pstrTimer));
+            pstrTimer->pfCallback(pstrTimer->pvCtx);
+            u8Calls--;
+         }while (u8Calls != 0 && pstrTimer->u8Active);
+      }
+   }
+   STimer_Program();
+}
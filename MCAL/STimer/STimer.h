@@ -0,0 +1,247 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: STimer.h
+* Description: File containing function prototypes for STimer.c
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __STIMER__
+#define __STIMER__
+
+#include "DataTypes.h"
+#include "Utils.h"
+#include "Register.h"
+#include "Atomic.h"
+#include "Timer.h"
+#include "Clock.h"
+
+/*
+ * Software timers on timer 1.
+ * Timer 1 runs free in normal mode and its overflow extends TCNT1 to a 32 bit tick count
+ * (STimer_Now), every deadline is a tick of that count and compared with signed differences so
+ * the wrap around is harmless. The output compare A interrupt is set on the earliest deadline.
+ *
+ * Each timer is a strSTimer_t owned by the caller (static or global, never on a stack that goes
+ * away while it runs). STimer_Create converts the times to ticks once, so STimer_Restart is a
+ * tick read and an add: restarting a running timer never walks the timer list. A restart that
+ * moves the earliest deadline later leaves the compare where it was, the interrupt then finds
+ * nothing due and sets the compare again.
+ *
+ * Coalescing: a timer may carry a slack, the time its callback may run late. The compare is set on
+ * the earliest deadline+slack of all running timers and every timer whose deadline has passed by
+ * then runs in the same interrupt, so timers with nearby deadlines share one wake up
+ * (like Linux timer slack). STimer_GetStats tells how many interrupts that saved. The slack is
+ * set after STimer_Create and the timeout plus slack can not exceed STIMER_MAX_US.
+ *
+ * Overruns: when a periodic timer is handled after its next period and that period's slack have
+ * passed (its callback or other interrupts took too long), the whole periods whose slack ran out
+ * are counted as missed and the timer's policy decides what happens to them:
+ *    STIMER_OVERRUN_ONCE     one callback for all of them, STimer_GetOverrun tells how many were
+ *                            missed, the timer keeps its phase (default)
+ *    STIMER_OVERRUN_SKIP     one callback, the missed periods are dropped and the next period
+ *                            starts now, the phase is lost
+ *    STIMER_OVERRUN_CATCHUP  the callback runs once more for every missed period in the same
+ *                            interrupt, up to STIMER_CATCHUP_MAX (the rest are dropped), the
+ *                            phase is kept
+ * The overrun hook (STimer_SetOverrunHook) runs before the callbacks of an overrun timer so the
+ * application can shed load, e.g. stop timers that are not essential.
+ *
+ * Timer 1 belongs to this driver once STimer_Init is called, so the ADC can not use the
+ * timer 1 compare B trigger at the same time.
+ */
+
+//timer 1 prescaler, one tick is 1 us or a whole fraction of it (Clock.h checks F_CPU)
+#if (CLOCK_MHZ % 8UL) == 0
+#define STIMER_PRESCALER         8UL
+#define STIMER_SCALER            TIMER1_SCALER_8
+#else
+#define STIMER_PRESCALER         1UL
+#define STIMER_SCALER            TIMER1_SCALER_1
+#endif
+
+#define STIMER_TICKS_PER_US      (CLOCK_MHZ/STIMER_PRESCALER)
+//shifts when the ticks per us are a power of two (1, 2, 4 MHz and all multiples of 8 MHz)
+#if   STIMER_TICKS_PER_US == 1
+#define STIMER_TICKS_SHIFT       0
+#elif STIMER_TICKS_PER_US == 2
+#define STIMER_TICKS_SHIFT       1
+#elif STIMER_TICKS_PER_US == 4
+#define STIMER_TICKS_SHIFT       2
+#endif
+#ifdef STIMER_TICKS_SHIFT
+#define STIMER_US_TO_TICKS(us)   ((uint32_t)(us)<<STIMER_TICKS_SHIFT)
+#define STIMER_TICKS_TO_US(t)    ((uint32_t)(t)>>STIMER_TICKS_SHIFT)
+#else
+#define STIMER_US_TO_TICKS(us)   ((uint32_t)(us)*STIMER_TICKS_PER_US)
+#define STIMER_TICKS_TO_US(t)    ((uint32_t)(t)/STIMER_TICKS_PER_US)
+#endif
+//deadlines are compared as signed 32 bit differences, a timeout or period plus its slack
+//(STimer_SetSlack) has to fit in STIMER_MAX_US too
+#define STIMER_MAX_US            (0x7FFFFFFFUL/STIMER_TICKS_PER_US)
+#define STIMER_MAX_TICKS         STIMER_US_TO_TICKS(STIMER_MAX_US)
+
+//most extra callbacks a STIMER_OVERRUN_CATCHUP timer gets in one interrupt
+#define STIMER_CATCHUP_MAX       8
+
+typedef void (*pfSTimerCallback_t)(void* pvCtx);
+
+typedef enum
+{
+   STIMER_OVERRUN_ONCE=0,
+   STIMER_OVERRUN_SKIP,
+   STIMER_OVERRUN_CATCHUP
+
+}enuSTimerOverrun_t;
+
+typedef struct strSTimer
+{
+   struct strSTimer*  pstrNext;
+   pfSTimerCallback_t pfCallback;
+   void*              pvCtx;
+   uint32_t           u32Deadline;      //tick of the next expiry
+   uint32_t           u32Timeout;       //ticks from a restart to the first expiry
+   uint32_t           u32Period;        //ticks between expiries, 0 for a one shot timer
+   uint32_t           u32Slack;         //ticks the expiry may be delayed to share an interrupt
+   uint16_t           u16Missed;        //periods missed before the expiry being delivered
+   uint16_t           u16MissedTotal;   //periods missed since STimer_Create, stops at 0xFFFF
+   enuSTimerOverrun_t enuOverrun;
+   volatile uint8_t   u8Active;
+   uint8_t            u8Due;            //set while the interrupt collects the due timers
+}strSTimer_t;
+
+typedef void (*pfSTimerOverrunHook_t)(strSTimer_t* pstrTimer, uint16_t u16Missed);
+
+typedef struct
+{
+   uint32_t u32Interrupts;       //compare interrupts taken
+   uint32_t u32Empty;            //interrupts with no timer due (far deadlines, restarted timers)
+   uint32_t u32Expirations;      //timer expiries handled
+   uint32_t u32Saved;            //expirations that shared an interrupt with an earlier one
+   uint32_t u32Missed;           //periods missed by all periodic timers
+}strSTimerStats_t;
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to start timer 1 as the free running time base of the software timers
+************************************************************************************/
+enuErrorStatus_t STimer_Init(void);
+
+/************************************************************************************
+* Parameters (in): strSTimer_t* pstrTimer, uint32_t u32TimeoutUs, uint32_t u32PeriodUs,
+*                  pfSTimerCallback_t pfCallback, void* pvCtx
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set up a timer that calls pfCallback(pvCtx) in interrupt context
+*              u32TimeoutUs after each restart and then every u32PeriodUs (0 for a one shot timer),
+*              both times can not exceed STIMER_MAX_US and the timer must not be running
+************************************************************************************/
+enuErrorStatus_t STimer_Create(strSTimer_t* pstrTimer, uint32_t u32TimeoutUs, uint32_t u32PeriodUs,
+                               pfSTimerCallback_t pfCallback, void* pvCtx);
+
+/************************************************************************************
+* Parameters (in): strSTimer_t* pstrTimer
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to start the timer, or start it over if it is running, with the timeout
+*              given to STimer_Create
+************************************************************************************/
+enuErrorStatus_t STimer_Restart(strSTimer_t* pstrTimer);
+
+/************************************************************************************
+* Parameters (in): strSTimer_t* pstrTimer, uint32_t u32SlackUs
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to let the timer run up to u32SlackUs late so it can share an interrupt
+*              with other timers (0 after STimer_Create), used from the next restart or expiry,
+*              the timeout and the period of the timer plus u32SlackUs can not exceed STIMER_MAX_US
+************************************************************************************/
+enuErrorStatus_t STimer_SetSlack(strSTimer_t* pstrTimer, uint32_t u32SlackUs);
+
+/************************************************************************************
+* Parameters (in): strSTimer_t* pstrTimer, enuSTimerOverrun_t enuOverrun
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to select what a periodic timer does with missed periods
+*              (STIMER_OVERRUN_ONCE after STimer_Create)
+************************************************************************************/
+enuErrorStatus_t STimer_SetOverrunPolicy(strSTimer_t* pstrTimer, enuSTimerOverrun_t enuOverrun);
+
+/************************************************************************************
+* Parameters (in): strSTimer_t* pstrTimer, uint16_t* pu16Missed, uint16_t* pu16MissedTotal
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the periods missed before the current (called from the callback)
+*              or last expiry, and since STimer_Create
+************************************************************************************/
+enuErrorStatus_t STimer_GetOverrun(strSTimer_t* pstrTimer, uint16_t* pu16Missed, uint16_t* pu16MissedTotal);
+
+/************************************************************************************
+* Parameters (in): pfSTimerOverrunHook_t pfHook
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set the function called in interrupt context with the timer and the
+*              number of missed periods whenever a periodic timer overruns (NULLPTR for none)
+************************************************************************************/
+enuErrorStatus_t STimer_SetOverrunHook(pfSTimerOverrunHook_t pfHook);
+
+/************************************************************************************
+* Parameters (in): strSTimer_t* pstrTimer
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop the timer, its callback is not called after this returns
+************************************************************************************/
+enuErrorStatus_t STimer_Stop(strSTimer_t* pstrTimer);
+
+/************************************************************************************
+* Parameters (in): strSTimer_t* pstrTimer, uint32_t u32DeltaUs
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (timer not running or too far)
+* Description: A function to move the next expiry of a running timer u32DeltaUs later, the time
+*              left to the expiry plus u32DeltaUs and the slack can not exceed STIMER_MAX_US
+************************************************************************************/
+enuErrorStatus_t STimer_Extend(strSTimer_t* pstrTimer, uint32_t u32DeltaUs);
+
+/************************************************************************************
+* Parameters (in): strSTimer_t* pstrTimer, uint32_t* pu32RemainingUs
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (timer not running)
+* Description: A function to read the time left until the next expiry in micro seconds
+************************************************************************************/
+enuErrorStatus_t STimer_Remaining(strSTimer_t* pstrTimer, uint32_t* pu32RemainingUs);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): uint32_t
+* Return value: the 32 bit tick count of the time base
+* Description: A function to read the time base, STIMER_TICKS_PER_US ticks per micro second
+************************************************************************************/
+uint32_t STimer_Now(void);
+
+/************************************************************************************
+* Parameters (in): strSTimerStats_t* pstrStats
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the interrupt and coalescing statistics since STimer_Init
+************************************************************************************/
+enuErrorStatus_t STimer_GetStats(strSTimerStats_t* pstrStats);
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Timer 1 overflow handler, extends the time base, dispatched by Vect.c
+************************************************************************************/
+void STimer_OVFHandler(void* pvCtx);
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Timer 1 compare A handler, calls the due timers, dispatched by Vect.c
+************************************************************************************/
+void STimer_CompareHandler(void* pvCtx);
+
+#endif /* __STIMER__ */
@@ -10,15 +10,73 @@
 
 
 #include "Timer.h"
+#include "Trace.h"
 
 #define T0_TICKS     256
 #define USEC_TO_SEC  1000000
+#define TIMER_SYNC_CS_MASK       0x07     //clock select bits, the same in TCCR0, TCCR1B and TCCR2
 
-void (*G_fptr)(void)=NULLPTR;
-uint64_t Gu32_T0MaxOVCount=0;
-uint64_t Gu32_T0CurrentOVCount=0;
-uint8_t  Gu32_T0LastOVTicks=0;
-uint16_t Gu16_T0Prescaler=0;
+//all timer 0 state in one place, the counter width comes from T0_MAX_DELAY_US (see Timer.h)
+typedef struct
+{
+   void (*pfCallback)(void);
+   void (*pfOVHook)(void);
+   T0OVCount_t MaxOVCount;
+   T0OVCount_t CurrentOVCount;
+   uint8_t     u8LastOVTicks;
+   uint16_t    u16Prescaler;
+}strT0State_t;
+
+strT0State_t Gstr_T0State={NULLPTR,NULLPTR,0,0,0,0};
+//achieved period and error of the last T0_Start, read with T0_GetAccuracy
+uint32_t Gu32_T0Cycles=0;
+sint32_t Gs32_T0ErrorPpm=0;
+
+#ifdef __AVR__
+STATIC_ASSERT(sizeof(strT0State_t)==T0_STATE_BYTES,T0_STATE_BYTES_mismatch);
+#endif
+
+//define TIMER_BUILD_REPORT to print the cost of every overflow counter width and the selected one
+//while building, lower T0_MAX_DELAY_US to move to a narrower width
+#ifdef TIMER_BUILD_REPORT
+#pragma message T0_STATE_REPORT_8
+#pragma message T0_STATE_REPORT_16
+#pragma message T0_STATE_REPORT_32
+#pragma message T0_STATE_REPORT
+#endif
+
+#ifdef T0_FAST_TICK
+//load the overflows left before the C handler runs, interrupts must be disabled
+static inline void T0_FastTickLoad(uint16_t u16Count)
+{
+   TWAR_R=(uint8_t)(u16Count>>8);
+   TWBR_R=(uint8_t)u16Count;
+}
+
+//called from the naked overflow ISR when the fast count runs out, not static as only the assembly calls it
+void T0_FastTickHandler(void);
+void T0_FastTickHandler(void)
+{
+   //another driver owns the overflow, it sees every one of them
+   if (Gstr_T0State.pfOVHook != NULLPTR)
+   {
+      T0_FastTickLoad(1);
+      Gstr_T0State.pfOVHook();
+      return;
+   }
+   //the time is up, the next period starts with the partial overflow
+   if (Gstr_T0State.u8LastOVTicks != 0)
+   {
+      TCNT0_R=(uint8_t)(T0_TICKS-Gstr_T0State.u8LastOVTicks);
+   }
+   T0_FastTickLoad((uint16_t)Gstr_T0State.MaxOVCount);
+   if (Gstr_T0State.pfCallback != NULLPTR)
+   {
+      TRACE(TRACE_EV_CALLBACK,TRACE_TIMER0);
+      Gstr_T0State.pfCallback();
+   }
+}
+#endif
 
 /************************************************************************************
 * Parameters (in): enuTimer0Mode_t enuMode,enuTimer0Scaler_t enuScaler
@@ -59,12 +117,15 @@ enuErrorStatus_t T0_Init(enuTimer0Mode_t enuMode,enuTimer0Scaler_t enuScaler)
    //set the prescaler value in a global variable for other functions to use
    switch(enuScaler)
    {
-      case TIMER0_STOP:          Gu16_T0Prescaler=0;       break;
-      case TIMER0_SCALER_1:      Gu16_T0Prescaler=1;       break;
-      case TIMER0_SCALER_8:      Gu16_T0Prescaler=8;       break;
-      case TIMER0_SCALER_64:     Gu16_T0Prescaler=64;      break;
-      case TIMER0_SCALER_256:    Gu16_T0Prescaler=256;     break;
-      case TIMER0_SCALER_1024:   Gu16_T0Prescaler=1024;    break;
+      case TIMER0_STOP:          Gstr_T0State.u16Prescaler=0;       break;
+      case TIMER0_SCALER_1:      Gstr_T0State.u16Prescaler=1;       break;
+      case TIMER0_SCALER_8:      Gstr_T0State.u16Prescaler=8;       break;
+      case TIMER0_SCALER_64:     Gstr_T0State.u16Prescaler=64;      break;
+      case TIMER0_SCALER_256:    Gstr_T0State.u16Prescaler=256;     break;
+      case TIMER0_SCALER_1024:   Gstr_T0State.u16Prescaler=1024;    break;
+      //the timer is clocked from the T0 pin, there is no time base to derive delays from
+      case EXTERNALl_FALLING:    Gstr_T0State.u16Prescaler=0;       break;
+      case EXTERNAL_RISING:      Gstr_T0State.u16Prescaler=0;       break;
       default:                                             break;
    }
    //return SUCCESS state
@@ -116,8 +177,8 @@ enuErrorStatus_t T0_OC0Mode(enuOC0Mode_t enuMode)
 ************************************************************************************/
 enuErrorStatus_t T0_OV_InterruptEnable(void)
 {
-   //set the TOIE bit to enable the overflow interrupt
-   SET_BIT(TIMSK_R,TOIE0_B);
+   //set the TOIE bit to enable the overflow interrupt, TIMSK is shared with other drivers' ISRs
+   Atomic_SetBits8(&TIMSK_R,(1<<TOIE0_B));
    return SUCCESS;
 }
 
@@ -130,7 +191,7 @@ enuErrorStatus_t T0_OV_InterruptEnable(void)
 enuErrorStatus_t T0_OV_InterruptDisable(void)
 {
    //clear the TOIE bit to enable the overflow interrupt
-   CLR_BIT(TIMSK_R,TOIE0_B);
+   Atomic_ClearBits8(&TIMSK_R,(1<<TOIE0_B));
    return SUCCESS;
 }
 
@@ -143,7 +204,7 @@ enuErrorStatus_t T0_OV_InterruptDisable(void)
 enuErrorStatus_t T0_OC_InterruptEnable(void)
 {
    //set the TOIE bit to enable output compare interrupt
-   SET_BIT(TIMSK_R,OCIE0_B);
+   Atomic_SetBits8(&TIMSK_R,(1<<OCIE0_B));
    return SUCCESS;
 }
 
@@ -156,7 +217,28 @@ enuErrorStatus_t T0_OC_InterruptEnable(void)
 enuErrorStatus_t T0_OC_InterruptDisable(void)
 {
    //clear the TOIE bit to enable output compare interrupt
-   CLR_BIT(TIMSK_R,OCIE0_B);
+   Atomic_ClearBits8(&TIMSK_R,(1<<OCIE0_B));
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): void(*pfHook)(void)
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to hand the timer 0 overflow interrupt to another driver (e.g. the
+*              event counter), the delay logic is bypassed while a hook is set, NULLPTR releases it
+************************************************************************************/
+enuErrorStatus_t T0_OVHookSet(void(*pfHook)(void))
+{
+   uint8_t u8Sreg;
+   //store the hook for the ISR to call instead of the delay logic
+   ATOMIC_ENTER(u8Sreg);
+   Gstr_T0State.pfOVHook=pfHook;
+#ifdef T0_FAST_TICK
+   //the hook has to see every overflow, let the next one through to the C handler
+   T0_FastTickLoad(1);
+#endif
+   ATOMIC_EXIT(u8Sreg);
    return SUCCESS;
 }
 
@@ -171,7 +253,8 @@ enuErrorStatus_t T0_OC_InterruptDisable(void)
 ************************************************************************************/
 enuErrorStatus_t T0_Start(uint64_t u64TimerValue, void(*pfCallback)(void))
 {
-   enuTimer0Scaler_t enuScaler=TIMER0_STOP;
+   strTimerSolution_t strSolution;
+   uint8_t u8Sreg;
    
    //check if the timer interrupts are enabled
    if (GET_BIT(TIMSK_R,TOIE0_B) || GET_BIT(TIMSK_R,OCIE0_B))
@@ -185,58 +268,53 @@ enuErrorStatus_t T0_Start(uint64_t u64TimerValue, void(*pfCallback)(void))
       else
       {
          //else store this pointer to function in the global pointer to function for the ISR to be able to execute
-         G_fptr=pfCallback;
+         Gstr_T0State.pfCallback=pfCallback;
       }
    }
    
-    //if the user sent a 0 time delay
-    if (u64TimerValue==0)
+    //if the user sent a 0 time delay or one longer than the counters were sized for
+    if (u64TimerValue==0 || u64TimerValue>T0_MAX_DELAY_US)
     {
        //return an error
        return ERROR;
     }
-    //else select the appropriate timer prescaler depending on the time sent for the least number of overflows
-    else if (u64TimerValue<=256)
-    {
-       enuScaler=TIMER0_SCALER_8;
-    }                                   
-    else if (u64TimerValue>256 && u64TimerValue<=2048)
-    {
-       enuScaler=TIMER0_SCALER_64;
-    }        
-    else if (u64TimerValue>2048 && u64TimerValue<=8192)       
-    {
-       enuScaler=TIMER0_SCALER_256;   
-    }
-    else                                                      
-    {
-       enuScaler=TIMER0_SCALER_1024;
-    }
     
-   //initialize the timer in normal mode with the new prescaler 
-   T0_Init(TIMER0_NORMAL_MODE,enuScaler);
+   //select the prescaler with the smallest error at 1 us resolution, then the fewest overflows,
+   //the delay is bounded by T0_MAX_DELAY_US so the cycle count fits 32 bits (checked in Timer.h),
+   //with OSC_TIMER_CORRECTION the cycles are scaled to the measured RC clock
+   if (TimerSolve(TIMERSOLVE_TIMER0,TIMERSOLVE_OVERFLOW,OSC_CORRECT(CLOCK_US_TO_CYCLES(u64TimerValue)),
+                  CLOCK_MHZ,T0_MAX_OVCOUNT,&strSolution) == ERROR)
+   {
+      return ERROR;
+   }
     
-   //calculate tick time of the selected prescaler
-   uint32_t u32TimerFreq=F_CPU/Gu16_T0Prescaler;
+   //initialize the timer in normal mode with the new prescaler 
+   T0_Init(TIMER0_NORMAL_MODE,(enuTimer0Scaler_t)strSolution.u8Scaler);
    
-   //calculate the number of overflows required to reach the selected time
-   Gu32_T0MaxOVCount=((u64TimerValue*u32TimerFreq)/(T0_TICKS*USEC_TO_SEC));
+   //the ticks of the first partial overflow, 0 if the period is whole overflows
+   uint8_t u8LastOVTicks=(uint8_t)strSolution.u16Top;
    
-   //calculate the time required to setup  the last overflow iteration
-   Gu32_T0LastOVTicks=((u64TimerValue*u32TimerFreq)/USEC_TO_SEC)-(Gu32_T0MaxOVCount*T0_TICKS);
-
-   
-   //if the time can be achieved without overflows
-   if (Gu32_T0MaxOVCount==0)
-   {
-      //set the timer value to overflow on the exact timing
-      TCNT0_R= (T0_TICKS-Gu32_T0LastOVTicks);
-   }
-   else
-   {
-      //else, set the overflow to 0
-      TCNT0_R=0;
-   }
+   //the overflows per period, the whole ones and the partial one
+   T0OVCount_t MaxOVCount=(T0OVCount_t)strSolution.u32Count+(u8LastOVTicks != 0);
+
+   //the ISR reads the counters, so publish them and the start value with interrupts masked
+   ATOMIC_ENTER(u8Sreg);
+   Gstr_T0State.MaxOVCount=MaxOVCount;
+   Gstr_T0State.u8LastOVTicks=u8LastOVTicks;
+   Gstr_T0State.CurrentOVCount=0;
+   //start with the partial overflow so the period is u32Count*256+u16Top ticks as solved,
+   //a 0 start value gives a whole first overflow
+   TCNT0_R=(uint8_t)(T0_TICKS-Gstr_T0State.u8LastOVTicks);
+   //an overflow left pending by a previous run would count as the first one
+   TIFR_R=(1<<TOV0_B);
+#ifdef T0_FAST_TICK
+   //the ISR counts the overflows, the C handler runs on the one that ends the period
+   T0_FastTickLoad((uint16_t)Gstr_T0State.MaxOVCount);
+#endif
+   Gu32_T0Cycles=strSolution.u32Cycles;
+   Gs32_T0ErrorPpm=strSolution.s32ErrorPpm;
+   ATOMIC_EXIT(u8Sreg);
+   TRACE(TRACE_EV_TIMER_START,TRACE_TIMER0);
    
    
    
@@ -254,24 +332,57 @@ enuErrorStatus_t T0_Start(uint64_t u64TimerValue, void(*pfCallback)(void))
 ************************************************************************************/
 enuErrorStatus_t T0_Stop(void)
 {
+   uint8_t u8Sreg;
    //turn off all timer interrupts
    T0_OV_InterruptDisable();
    T0_OC_InterruptDisable();
    //initialize the timer with no clock to stop it
    T0_Init(TIMER0_NORMAL_MODE,TIMER0_STOP);
-   //clear the timer overflow flag
-   SET_BIT(TIFR_R,TOV0_B);
+   //clear the timer overflow flag, TIFR flags are cleared by writing one so only this bit is written
+   TIFR_R=(1<<TOV0_B);
    
    //reset all global variables
-   Gu32_T0MaxOVCount=0;
-   Gu32_T0LastOVTicks=0;
-   Gu32_T0CurrentOVCount=0;
+   ATOMIC_ENTER(u8Sreg);
+   Gstr_T0State.MaxOVCount=0;
+   Gstr_T0State.u8LastOVTicks=0;
+   Gstr_T0State.CurrentOVCount=0;
+   ATOMIC_EXIT(u8Sreg);
+   TRACE(TRACE_EV_TIMER_STOP,TRACE_TIMER0);
    
    //return success state
    return SUCCESS;
 }
 
 
+/************************************************************************************
+* Parameters (in): uint32_t* pu32Cycles, sint32_t* ps32ErrorPpm
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (no T0_Start yet)
+* Description: A function to get the period the last T0_Start achieved in CPU cycles and its
+*              error from the requested delay in ppm, with OSC_TIMER_CORRECTION the cycles are
+*              of the measured RC clock
+************************************************************************************/
+enuErrorStatus_t T0_GetAccuracy(uint32_t* pu32Cycles, sint32_t* ps32ErrorPpm)
+{
+   uint8_t u8Sreg;
+   if (pu32Cycles == NULLPTR || ps32ErrorPpm == NULLPTR)
+   {
+      return ERROR;
+   }
+   //both are written by T0_Start, which may run from an ISR
+   ATOMIC_ENTER(u8Sreg);
+   *pu32Cycles=Gu32_T0Cycles;
+   *ps32ErrorPpm=Gs32_T0ErrorPpm;
+   ATOMIC_EXIT(u8Sreg);
+   //no period was solved yet
+   if (*pu32Cycles == 0)
+   {
+      return ERROR;
+   }
+   return SUCCESS;
+}
+
+
 /************************************************************************************
 * Parameters (in): void
 * Parameters (out): enuErrorStatus_t
@@ -280,37 +391,37 @@ enuErrorStatus_t T0_Stop(void)
 ************************************************************************************/
 enuErrorStatus_t T0_GetStatus(void)
 {
+      uint8_t u8Sreg;
+      uint8_t u8TimeUp=0;
+      //the counters are wider than a byte and may be shared with the ISR
+      ATOMIC_ENTER(u8Sreg);
       //if the current overflow value is less than the total overflows value
-      if (Gu32_T0CurrentOVCount < Gu32_T0MaxOVCount)
+      if (Gstr_T0State.CurrentOVCount < Gstr_T0State.MaxOVCount)
       {
          //check the over flow flag
          if (GET_BIT(TIFR_R,TOV0_B))
          {
             //if set, clear it
-            SET_BIT(TIFR_R,TOV0_B);
+            TIFR_R=(1<<TOV0_B);
             //and increase the overflow counter
-            Gu32_T0CurrentOVCount++;
+            Gstr_T0State.CurrentOVCount++;
          }
       }
-      //if the current overflow value equals the calculated total overflows value
-      else if (Gu32_T0CurrentOVCount == Gu32_T0MaxOVCount)
+      //the time is up on the last overflow, the partial one was the first
+      if (Gstr_T0State.CurrentOVCount >= Gstr_T0State.MaxOVCount)
       {
-         //set the timer value to the remaining timing
-         TCNT0_R=((T0_TICKS-1)-Gu32_T0LastOVTicks);
-         //clear the overflow flag
-         SET_BIT(TIFR_R,TOV0_B);
-         //increase the overflow counter
-         Gu32_T0CurrentOVCount++;
+         u8TimeUp=1;
       }
+      ATOMIC_EXIT(u8Sreg);
       
-      //if the time is up
-      else
+      //the callback runs with the previous interrupt state
+      if (u8TimeUp)
       {
          //check if the global pointer to function holds a valid function address
-         if (G_fptr != NULLPTR)
+         if (Gstr_T0State.pfCallback != NULLPTR)
          {
             //if so, call the function
-            G_fptr();
+            Gstr_T0State.pfCallback();
          }
          //stop the timer
          T0_Stop();
@@ -328,36 +439,104 @@ enuErrorStatus_t T0_GetStatus(void)
 
 /******************** ISR FUNCTIONS ****************************************/
 
-//ISR function to run in case  of a timer overflow interrupt
-ISR(TIMER0_OVF_vect)
+#ifdef T0_FAST_TICK
+//ISR function to run in case  of a timer overflow interrupt, counts down in TWAR:TWBR and only
+//saves the rest of the call clobbered registers when the C handler has to run
+ISR(TIMER0_OVF_vect,ISR_NAKED)
 {
-   //if the current overflow value is less than the total overflows value
-   if (Gu32_T0CurrentOVCount < Gu32_T0MaxOVCount)
-   {
-      //increase the overflow counter
-      Gu32_T0CurrentOVCount++;
-   }
-   //if the current overflow value equals the calculated total overflows value
-   else if (Gu32_T0CurrentOVCount == Gu32_T0MaxOVCount)
+   __asm__ __volatile__
+   (
+      "push r24                     \n\t"
+      "in   r24,%[sreg]             \n\t"
+      "push r24                     \n\t"
+      //decrement the low byte, a borrow goes to the high byte
+      "in   r24,%[lo]               \n\t"
+      "subi r24,1                   \n\t"
+      "out  %[lo],r24               \n\t"
+      "brcs 1f                      \n\t"
+      "brne 2f                      \n\t"
+      //low byte reached zero, the count ran out if the high byte is zero too
+      "in   r24,%[hi]               \n\t"
+      "tst  r24                     \n\t"
+      "brne 2f                      \n\t"
+      "push r0                      \n\t"
+      "push r1                      \n\t"
+      "push r18                     \n\t"
+      "push r19                     \n\t"
+      "push r20                     \n\t"
+      "push r21                     \n\t"
+      "push r22                     \n\t"
+      "push r23                     \n\t"
+      "push r25                     \n\t"
+      "push r26                     \n\t"
+      "push r27                     \n\t"
+      "push r30                     \n\t"
+      "push r31                     \n\t"
+      "clr  r1                      \n\t"
+      "call T0_FastTickHandler      \n\t"
+      "pop  r31                     \n\t"
+      "pop  r30                     \n\t"
+      "pop  r27                     \n\t"
+      "pop  r26                     \n\t"
+      "pop  r25                     \n\t"
+      "pop  r23                     \n\t"
+      "pop  r22                     \n\t"
+      "pop  r21                     \n\t"
+      "pop  r20                     \n\t"
+      "pop  r19                     \n\t"
+      "pop  r18                     \n\t"
+      "pop  r1                      \n\t"
+      "pop  r0                      \n\t"
+      "rjmp 2f                      \n\t"
+      "1:                           \n\t"
+      "in   r24,%[hi]               \n\t"
+      "dec  r24                     \n\t"
+      "out  %[hi],r24               \n\t"
+      "2:                           \n\t"
+      "pop  r24                     \n\t"
+      "out  %[sreg],r24             \n\t"
+      "pop  r24                     \n\t"
+      "reti                         \n\t"
+      :: [sreg] "I" (SREG_IO), [lo] "I" (TWBR_IO), [hi] "I" (TWAR_IO)
+   );
+}
+#else
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Timer 0 overflow handler, dispatched by Vect.c (see Vect_Cfg.c)
+************************************************************************************/
+void T0_OVFHandler(void* pvCtx)
+{
+   //if another driver owns the timer overflow, pass the interrupt to it
+   if (Gstr_T0State.pfOVHook != NULLPTR)
    {
-      //set the timer value to the remaining timing
-      TCNT0_R=((T0_TICKS-1)-Gu32_T0LastOVTicks);
-      //increase the overflow counter
-      Gu32_T0CurrentOVCount++;
+      Gstr_T0State.pfOVHook();
+      return;
    }
-   //if the time is up
-   else
+   //increase the overflow counter
+   Gstr_T0State.CurrentOVCount++;
+   //if the time is up on the last overflow
+   if (Gstr_T0State.CurrentOVCount >= Gstr_T0State.MaxOVCount)
    {
       //reset the overflow counter
-      Gu32_T0CurrentOVCount=0;
+      Gstr_T0State.CurrentOVCount=0;
+      //the next period starts with the partial overflow, the timer counts on from 0 otherwise
+      if (Gstr_T0State.u8LastOVTicks != 0)
+      {
+         TCNT0_R=(uint8_t)(T0_TICKS-Gstr_T0State.u8LastOVTicks);
+      }
       //check if the global pointer to function holds a valid function address
-      if (G_fptr != NULLPTR)
+      if (Gstr_T0State.pfCallback != NULLPTR)
       {
          //call the function
-         G_fptr();
+         TRACE(TRACE_EV_CALLBACK,TRACE_TIMER0);
+         Gstr_T0State.pfCallback();
       }
    }      
 }
+#endif
 
 
 /*******************************************************************************************/
@@ -365,6 +544,19 @@ ISR(TIMER0_OVF_vect)
 
 /******************************** Timer 1 Functions ****************************************/
 
+//complementary PWM, OC1A on PD5 and OC1B on PD4
+#define T1_COMP_PINS       ((1<<5) | (1<<4))
+
+typedef struct
+{
+   uint16_t u16Top;           //0 until Timer1_ComplementaryInit
+   uint16_t u16Dead;
+   uint16_t u16Duty;
+   uint8_t  u8Scaler;
+}strT1CompState_t;
+
+strT1CompState_t Gstr_T1CompState={0,0,0,0};
+
 
 
 /************************************************************************************
@@ -520,7 +712,7 @@ enuErrorStatus_t Timer1_OCRB1Mode(enuOC1B_Mode_t enu_oc1b_mode)
 enuErrorStatus_t Timer1_OVF_InterruptEnable(void)
 {
    //set the appropriate pin in the TIMSK register to enable overflow interrupt
-   SET_BIT(TIMSK_R,TOIE1_B);
+   Atomic_SetBits8(&TIMSK_R,(1<<TOIE1_B));
    return SUCCESS;
 }
 
@@ -533,7 +725,7 @@ enuErrorStatus_t Timer1_OVF_InterruptEnable(void)
 enuErrorStatus_t Timer1_OVF_InterruptDisable(void)
 {
    //clear the appropriate pin in the TIMSK register to disable overflow interrupt
-   CLR_BIT(TIMSK_R,TOIE1_B);
+   Atomic_ClearBits8(&TIMSK_R,(1<<TOIE1_B));
    return SUCCESS;
 }
 
@@ -546,7 +738,7 @@ enuErrorStatus_t Timer1_OVF_InterruptDisable(void)
 enuErrorStatus_t Timer1_OCA_InterruptEnable(void)
 {
    //set the appropriate pin in the TIMSK register to enable output compare A interrupt
-   SET_BIT(TIMSK_R,OCIE1A_B);
+   Atomic_SetBits8(&TIMSK_R,(1<<OCIE1A_B));
    return SUCCESS;
 }
 
@@ -559,7 +751,7 @@ enuErrorStatus_t Timer1_OCA_InterruptEnable(void)
 enuErrorStatus_t Timer1_OCA_InterruptDisable(void)
 {
    //Clear the appropriate pin in the TIMSK register to disable output compare B interrupt
-   CLR_BIT(TIMSK_R,OCIE1A_B);
+   Atomic_ClearBits8(&TIMSK_R,(1<<OCIE1A_B));
    return SUCCESS;
 }
 
@@ -572,7 +764,7 @@ enuErrorStatus_t Timer1_OCA_InterruptDisable(void)
 enuErrorStatus_t Timer1_OCB_InterruptEnable(void)
 {
    //set the appropriate pin in the TIMSK register to enable output compare B interrupt
-   SET_BIT(TIMSK_R,OCIE1B_B);
+   Atomic_SetBits8(&TIMSK_R,(1<<OCIE1B_B));
    return SUCCESS;
 }
 
@@ -585,6 +777,204 @@ enuErrorStatus_t Timer1_OCB_InterruptEnable(void)
 enuErrorStatus_t Timer1_OCB_InterruptDisable(void)
 {
    //Clear the appropriate pin in the TIMSK register to disable output compare A interrupt
-   CLR_BIT(TIMSK_R,OCIE1B_B);
+   Atomic_ClearBits8(&TIMSK_R,(1<<OCIE1B_B));
+   return SUCCESS;
+}
+
+
+/************************************************************************************
+* Parameters (in): uint32_t u32FreqHz, uint16_t u16DeadTicks, uint16_t* pu16Top
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (no setting for u32FreqHz or the dead time takes the period)
+* Description: A function to start timer 1 at the closest PWM frequency to u32FreqHz with the
+*              outputs shut down and duty 0, pu16Top gets TOP (duty runs 0 to TOP-u16DeadTicks)
+************************************************************************************/
+enuErrorStatus_t Timer1_ComplementaryInit(uint32_t u32FreqHz, uint16_t u16DeadTicks, uint16_t* pu16Top)
+{
+   strTimerSolution_t strSolution;
+   uint8_t u8Sreg;
+
+   if (u32FreqHz == 0 || u32FreqHz > F_CPU/4 || pu16Top == NULLPTR)
+   {
+      return ERROR;
+   }
+   //a period is 2*TOP ticks, so half of it is one CTC period of TOP ticks
+   if (TimerSolve(TIMERSOLVE_TIMER1,TIMERSOLVE_CTC,(F_CPU+u32FreqHz)/(2*u32FreqHz),1,1,&strSolution) == ERROR ||
+       strSolution.u16Top == 0xFFFF || (uint32_t)u16DeadTicks >= (uint32_t)strSolution.u16Top+1)
+   {
+      return ERROR;
+   }
+
+   ATOMIC_ENTER(u8Sreg);
+   //outputs disconnected and their pins driven low
+   TCCR1A_R=0;
+   TCCR1B_R=0;
+   PORTD_R&=(uint8_t)~T1_COMP_PINS;
+   DDRD_R|=T1_COMP_PINS;
+   Gstr_T1CompState.u16Top=strSolution.u16Top+1;
+   Gstr_T1CompState.u16Dead=u16DeadTicks;
+   Gstr_T1CompState.u16Duty=0;
+   Gstr_T1CompState.u8Scaler=strSolution.u8Scaler;
+   ICR1_R=Gstr_T1CompState.u16Top;
+   OCR1A_R=0;
+   OCR1B_R=u16DeadTicks;
+   TCNT1_R=0;
+   //phase and frequency correct, TOP=ICR1
+   TCCR1B_R=(1<<WGM13_B) | strSolution.u8Scaler;
+   ATOMIC_EXIT(u8Sreg);
+   *pu16Top=Gstr_T1CompState.u16Top;
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint16_t u16Duty
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (duty above TOP-dead time)
+* Description: A function to set the high side on time to u16Duty ticks per half period, the new
+*              duty starts together for both outputs at the next BOTTOM
+************************************************************************************/
+enuErrorStatus_t Timer1_ComplementarySetDuty(uint16_t u16Duty)
+{
+   uint8_t u8Sreg;
+   if (Gstr_T1CompState.u16Top == 0 || u16Duty > Gstr_T1CompState.u16Top-Gstr_T1CompState.u16Dead)
+   {
+      return ERROR;
+   }
+   //the 16 bit writes share the TEMP register, and the order keeps OCR1B-OCR1A at least the
+   //dead time in the buffers whichever write BOTTOM comes after
+   ATOMIC_ENTER(u8Sreg);
+   if (u16Duty > Gstr_T1CompState.u16Duty)
+   {
+      OCR1B_R=u16Duty+Gstr_T1CompState.u16Dead;
+      OCR1A_R=u16Duty;
+   }
+   else
+   {
+      OCR1A_R=u16Duty;
+      OCR1B_R=u16Duty+Gstr_T1CompState.u16Dead;
+   }
+   Gstr_T1CompState.u16Duty=u16Duty;
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (Timer1_ComplementaryInit not called)
+* Description: A function to connect the outputs after Timer1_ComplementaryInit or a shutdown,
+*              the period starts over from BOTTOM
+************************************************************************************/
+enuErrorStatus_t Timer1_ComplementaryEnable(void)
+{
+   uint8_t u8Sreg;
+   if (Gstr_T1CompState.u16Top == 0)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   TCCR1B_R=0;
+   //tri-state the pins while the latches are cleared, forced compares only work in normal mode
+   DDRD_R&=(uint8_t)~T1_COMP_PINS;
+   TCCR1A_R=(1<<COM1A1_B) | (1<<COM1B1_B);
+   TCCR1A_R=(1<<COM1A1_B) | (1<<COM1B1_B) | (1<<FOC1A_B) | (1<<FOC1B_B);
+   //both latches low: OC1A goes high on the first down count match, OC1B on the first up count match
+   TCCR1A_R=(1<<COM1A1_B) | (1<<COM1B1_B) | (1<<COM1B0_B);
+   TCNT1_R=0;
+   DDRD_R|=T1_COMP_PINS;
+   TCCR1B_R=(1<<WGM13_B) | Gstr_T1CompState.u8Scaler;
+   ATOMIC_EXIT(u8Sreg);
    return SUCCESS;
-}
\ No newline at end of file
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): void
+* Return value: void
+* Description: A function to force both outputs low at once, callable from an ISR, the timer
+*              keeps running
+************************************************************************************/
+void Timer1_ComplementaryShutdown(void)
+{
+   //COM bits cleared in one write, the pins fall back to their low PORT bits
+   TCCR1A_R=0;
+}
+
+
+/********************************** Synchronized Start ************************************/
+
+/************************************************************************************
+* Parameters (in): const strTimerSync_t* pstrSync
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (a timer not set up with an internal prescaler)
+* Description: A function to start the selected timers on the same prescaler edge with their
+*              counts at the requested phase offsets
+************************************************************************************/
+enuErrorStatus_t Timer_SyncStart(const strTimerSync_t* pstrSync)
+{
+   uint8_t u8Sreg;
+   uint8_t u8Tccr0,u8Tccr1b,u8Tccr2;
+   uint8_t u8Sfior;
+   uint8_t u8Reset=0;
+
+   if (pstrSync == NULLPTR || pstrSync->u8Timers == 0 ||
+       (pstrSync->u8Timers & ~(TIMER_SYNC_T0 | TIMER_SYNC_T1 | TIMER_SYNC_T2)))
+   {
+      return ERROR;
+   }
+   //each timer starts with the prescaler its init gave it, the external clocks have none to reset
+   if ((pstrSync->u8Timers & TIMER_SYNC_T0) &&
+       ((TCCR0_R & TIMER_SYNC_CS_MASK) == TIMER0_STOP || (TCCR0_R & TIMER_SYNC_CS_MASK) >= EXTERNALl_FALLING))
+   {
+      return ERROR;
+   }
+   if ((pstrSync->u8Timers & TIMER_SYNC_T1) &&
+       ((TCCR1B_R & TIMER_SYNC_CS_MASK) == TIMER1_STOP || (TCCR1B_R & TIMER_SYNC_CS_MASK) >= EXTERNAL0_FALLING))
+   {
+      return ERROR;
+   }
+   if ((pstrSync->u8Timers & TIMER_SYNC_T2) && ((TCCR2_R & TIMER_SYNC_CS_MASK) == 0 || GET_BIT(ASSR_R,AS2_B)))
+   {
+      return ERROR;
+   }
+
+   ATOMIC_ENTER(u8Sreg);
+   u8Tccr0=TCCR0_R;
+   u8Tccr1b=TCCR1B_R;
+   u8Tccr2=TCCR2_R;
+   //stop the selected timers and set their counts, a clk/1 timer starts the cycles after the
+   //reset its clock select is written on (1 for timer 0, 2 for timer 1, 3 for timer 2)
+   if (pstrSync->u8Timers & TIMER_SYNC_T0)
+   {
+      TCCR0_R=u8Tccr0 & (uint8_t)~TIMER_SYNC_CS_MASK;
+      TCNT0_R=pstrSync->u8T0Count+(((u8Tccr0 & TIMER_SYNC_CS_MASK) == TIMER0_SCALER_1) ? 1 : 0);
+      u8Reset|=(1<<PSR10_B);
+   }
+   if (pstrSync->u8Timers & TIMER_SYNC_T1)
+   {
+      TCCR1B_R=u8Tccr1b & (uint8_t)~TIMER_SYNC_CS_MASK;
+      TCNT1_R=pstrSync->u16T1Count+(((u8Tccr1b & TIMER_SYNC_CS_MASK) == TIMER1_SCALER_1) ? 2 : 0);
+      u8Reset|=(1<<PSR10_B);
+   }
+   if (pstrSync->u8Timers & TIMER_SYNC_T2)
+   {
+      TCCR2_R=u8Tccr2 & (uint8_t)~TIMER_SYNC_CS_MASK;
+      TCNT2_R=pstrSync->u8T2Count+(((u8Tccr2 & TIMER_SYNC_CS_MASK) == 1) ? 3 : 0);
+      u8Reset|=(1<<PSR2_B);
+   }
+   u8Sfior=SFIOR_R | u8Reset;
+   //reset the prescalers and write the clock selects back on the next three cycles, a timer
+   //outside the set gets the value it already has
+   __asm__ __volatile__
+   (
+      "out  %[sfior],%[reset]       \n\t"
+      "out  %[tccr0],%[t0]          \n\t"
+      "out  %[tccr1b],%[t1]         \n\t"
+      "out  %[tccr2],%[t2]          \n\t"
+      :: [sfior] "I" (SFIOR_IO), [tccr0] "I" (TCCR0_IO), [tccr1b] "I" (TCCR1B_IO), [tccr2] "I" (TCCR2_IO),
+         [reset] "r" (u8Sfior), [t0] "r" (u8Tccr0), [t1] "r" (u8Tccr1b), [t2] "r" (u8Tccr2)
+      : "memory"
+   );
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
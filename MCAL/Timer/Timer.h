@@ -12,6 +12,60 @@
 #include "DataTypes.h"
 #include "Utils.h"
 #include "Register.h"
+#include "Atomic.h"
+#include "Clock.h"
+#include "TimerSolve.h"
+
+/********************************** Timer 0 Configuration *********************************/
+
+//longest delay T0_Start accepts, it sets the width of the overflow counters
+#ifndef T0_MAX_DELAY_US
+#define T0_MAX_DELAY_US          10000000UL
+#endif
+
+#if (T0_MAX_DELAY_US*CLOCK_MHZ) > TIMERSOLVE_MAX_CYCLES
+#error "Timer: T0_MAX_DELAY_US is too long for 32 bit tick math at this F_CPU"
+#endif
+
+//overflows of the longest delay at the largest prescaler (1024) and 256 ticks per overflow,
+//+1 as the solver rounds the ticks to the nearest
+#define T0_MAX_OVCOUNT           ((T0_MAX_DELAY_US*CLOCK_MHZ)/(1024UL*256UL)+1)
+
+//cost of every overflow counter width, state size = 7 bytes + 2 counters
+//cycles are the ISR counter compare and increment, the former uint64_t counters took ~45
+//the limit is T0_MAX_DELAY_US*CLOCK_MHZ (the longest delay in cycles) that still fits the width
+#define T0_STATE_REPORT_8        "Timer0: 8 bit overflow counters, 9 bytes RAM, ~7 cycles per overflow, delays below 66584576 cycles"
+#define T0_STATE_REPORT_16       "Timer0: 16 bit overflow counters, 11 bytes RAM, ~12 cycles per overflow, every delay the 32 bit tick math allows"
+#define T0_STATE_REPORT_32       "Timer0: 32 bit overflow counters, 15 bytes RAM, ~22 cycles per overflow, only past the 32 bit tick math"
+
+//narrowest counter that holds the overflow count + 1
+#if T0_MAX_OVCOUNT < 0xFF
+typedef uint8_t                  T0OVCount_t;
+#define T0_STATE_BYTES           9
+#define T0_STATE_REPORT          "Timer0 selected: 8 bit overflow counters"
+#elif T0_MAX_OVCOUNT < 0xFFFF
+typedef uint16_t                 T0OVCount_t;
+#define T0_STATE_BYTES           11
+#define T0_STATE_REPORT          "Timer0 selected: 16 bit overflow counters"
+#else
+typedef uint32_t                 T0OVCount_t;
+#define T0_STATE_BYTES           15
+#define T0_STATE_REPORT          "Timer0 selected: 32 bit overflow counters"
+#endif
+
+/*
+ * Fast tick (define T0_FAST_TICK): the timer 0 overflow ISR becomes a naked assembly routine
+ * that counts down the overflows left before the C code has work to do, in TWBR (low byte)
+ * and TWAR (high byte), two I/O registers reachable with in/out that are free while the TWI
+ * is unused. It saves only r24 and SREG: ~28 cycles per overflow against ~95 for the C ISR
+ * with its full register save. The C handler only runs when the count runs out: on the
+ * deadline, where it preloads the next partial overflow, and on every overflow while a
+ * T0_OVHookSet hook is set.
+ * The TWI can not be used together with T0_FAST_TICK.
+ */
+#if defined(T0_FAST_TICK) && T0_MAX_OVCOUNT >= 0xFFFF
+#error "Timer: T0_FAST_TICK counts overflows in 16 bits, lower T0_MAX_DELAY_US"
+#endif
 
 typedef enum{
 	TIMER0_STOP,
@@ -94,12 +148,22 @@ enuErrorStatus_t T0_OC_InterruptEnable(void);
 ************************************************************************************/
 enuErrorStatus_t T0_OC_InterruptDisable(void);
 
+/************************************************************************************
+* Parameters (in): void(*pfHook)(void)
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to hand the timer 0 overflow interrupt to another driver (e.g. the
+*              event counter), the delay logic is bypassed while a hook is set, NULLPTR releases it
+************************************************************************************/
+enuErrorStatus_t T0_OVHookSet(void(*pfHook)(void));
+
 //Timer Ctrl Functions
 /************************************************************************************
 * Parameters (in): uint64_t u64TimerValue, void(*pfCallback)(void)
 * Parameters (out): enuErrorStatus_t
 * Return value: 1=SUCCESS or 0=FAIL
-* Description: A function to start the timer and set a callback funtion to be called when time runs up
+* Description: A function to start the timer and set a callback funtion to be called when time runs up,
+*              u64TimerValue is in micro seconds and can not exceed T0_MAX_DELAY_US
 ************************************************************************************/
 enuErrorStatus_t T0_Start(uint64_t u64TimerValue, void(*pfCallback)(void));
 
@@ -111,6 +175,16 @@ enuErrorStatus_t T0_Start(uint64_t u64TimerValue, void(*pfCallback)(void));
 ************************************************************************************/
 enuErrorStatus_t T0_Stop(void);
 
+/************************************************************************************
+* Parameters (in): uint32_t* pu32Cycles, sint32_t* ps32ErrorPpm
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (no T0_Start yet)
+* Description: A function to get the period the last T0_Start achieved in CPU cycles and its
+*              error from the requested delay in ppm, with OSC_TIMER_CORRECTION the cycles are
+*              of the measured RC clock
+************************************************************************************/
+enuErrorStatus_t T0_GetAccuracy(uint32_t* pu32Cycles, sint32_t* ps32ErrorPpm);
+
 /************************************************************************************
 * Parameters (in): void
 * Parameters (out): enuErrorStatus_t
@@ -119,6 +193,16 @@ enuErrorStatus_t T0_Stop(void);
 ************************************************************************************/
 enuErrorStatus_t T0_GetStatus(void);
 
+#ifndef T0_FAST_TICK
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Timer 0 overflow handler, dispatched by Vect.c (see Vect_Cfg.c)
+************************************************************************************/
+void T0_OVFHandler(void* pvCtx);
+#endif
+
 
 
 /******************************************************************************************/
@@ -242,5 +326,107 @@ enuErrorStatus_t Timer1_OCB_InterruptEnable(void);
 enuErrorStatus_t Timer1_OCB_InterruptDisable(void);
 
 
+/*
+ * Complementary PWM for a half bridge on OC1A (PD5, high side, non inverting) and OC1B (PD4,
+ * low side, inverting), timer 1 in phase and frequency correct mode with ICR1 as TOP.
+ * OCR1A=duty and OCR1B=duty+dead, so on both slopes OC1A falls u16DeadTicks before OC1B
+ * rises and OC1B falls u16DeadTicks before OC1A rises:
+ *    OC1A high  2*duty ticks of the 2*TOP period
+ *    OC1B high  2*(TOP-duty-dead) ticks
+ *    both low   2*dead ticks, one dead time at each edge
+ * The compare registers are double buffered to BOTTOM and Timer1_ComplementarySetDuty writes
+ * them in the order that keeps the dead time if BOTTOM falls between the two writes (OCR1B
+ * first when the duty grows, OCR1A first when it shrinks), so no period ever sees an overlap.
+ *
+ * Timer1_ComplementaryShutdown disconnects both outputs with a single out to TCCR1A (the mode
+ * has no WGM bits there), PD4/PD5 then follow their PORT bits which are kept low: both pins
+ * are low on the first instruction of the call, 5 cycles after a call from a fault ISR.
+ * Timer1_ComplementaryEnable clears both compare output latches (forced compare in normal mode
+ * with the pins tri-stated for ~10 cycles, the gate driver inputs should have pull downs)
+ * before it connects them again, so a stale latch can not turn both switches on.
+ *
+ * Timer 1 is the software timer time base, STimer can not run at the same time.
+ */
+
+/************************************************************************************
+* Parameters (in): uint32_t u32FreqHz, uint16_t u16DeadTicks, uint16_t* pu16Top
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (no setting for u32FreqHz or the dead time takes the period)
+* Description: A function to start timer 1 at the closest PWM frequency to u32FreqHz with the
+*              outputs shut down and duty 0, pu16Top gets TOP (duty runs 0 to TOP-u16DeadTicks)
+************************************************************************************/
+enuErrorStatus_t Timer1_ComplementaryInit(uint32_t u32FreqHz, uint16_t u16DeadTicks, uint16_t* pu16Top);
+
+/************************************************************************************
+* Parameters (in): uint16_t u16Duty
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (duty above TOP-dead time)
+* Description: A function to set the high side on time to u16Duty ticks per half period, the new
+*              duty starts together for both outputs at the next BOTTOM
+************************************************************************************/
+enuErrorStatus_t Timer1_ComplementarySetDuty(uint16_t u16Duty);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (Timer1_ComplementaryInit not called)
+* Description: A function to connect the outputs after Timer1_ComplementaryInit or a shutdown,
+*              the period starts over from BOTTOM
+************************************************************************************/
+enuErrorStatus_t Timer1_ComplementaryEnable(void);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): void
+* Return value: void
+* Description: A function to force both outputs low at once, callable from an ISR, the timer
+*              keeps running
+************************************************************************************/
+void Timer1_ComplementaryShutdown(void);
+
+
+/********************************** Synchronized Start ************************************/
+
+/*
+ * Timer_SyncStart starts timers 0, 1 and 2 in phase.
+ * The selected timers are stopped, their TCNT set to the requested counts, then one
+ * instruction sequence resets the prescalers (PSR10 for timers 0/1, PSR2 for timer 2 in SFIOR)
+ * and writes the three clock selects back on the next 3 cycles. A prescaled timer counts its
+ * first tick N cycles after the reset whichever cycle its clock select came on, so with
+ * prescalers of 8 and up the timers are aligned to the cycle. A timer at clk/1 counts from its
+ * own write, 1 to 3 cycles after the reset, and gets those cycles added to its count so every
+ * timer reads as if it started on the reset (from the instruction timing, not measured).
+ * Modes, TOPs, compares and output modes stay as the init functions set them, the prescaler
+ * each timer had is the one it starts with.
+ *
+ * The ATmega32 has no TSM bit to hold the prescalers in reset, so the reset is the single cycle
+ * write and the start has to follow it at once, hence the fixed out sequence with interrupts
+ * masked. The timers 0/1 prescaler reset also moves a running timer 0 or 1 that is not in the
+ * set (the software timer time base) by up to one of its prescaler periods. Timer 2 clocked
+ * from the 32 kHz crystal (Osc) can not be synchronized.
+ */
+
+#define TIMER_SYNC_T0            (1<<0)
+#define TIMER_SYNC_T1            (1<<1)
+#define TIMER_SYNC_T2            (1<<2)
+//count u16Deg degrees into a period of u16Top+1 counts (counting up, single slope modes)
+#define TIMER_SYNC_PHASE(u16Top,u16Deg)   ((uint16_t)((((uint32_t)(u16Top)+1UL)*(u16Deg))/360UL))
+
+typedef struct
+{
+   uint8_t  u8Timers;         //TIMER_SYNC_T0 | TIMER_SYNC_T1 | TIMER_SYNC_T2
+   uint8_t  u8T0Count;        //TCNT of each timer when they start
+   uint16_t u16T1Count;
+   uint8_t  u8T2Count;
+}strTimerSync_t;
+
+/************************************************************************************
+* Parameters (in): const strTimerSync_t* pstrSync
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (a timer not set up with an internal prescaler)
+* Description: A function to start the selected timers on the same prescaler edge with their
+*              counts at the requested phase offsets
+************************************************************************************/
+enuErrorStatus_t Timer_SyncStart(const strTimerSync_t* pstrSync);
 
-#endif /* __TIMER__ */
\ No newline at end of file
+#endif /* __TIMER__ */
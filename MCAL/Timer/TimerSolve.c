@@ -0,0 +1,168 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: TimerSolve.c
+* Description: File containing the timer prescaler and reload solver
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#include "TimerSolve.h"
+
+//timer clock prescalers as powers of two (1,8,64,256,1024 and 1,8,32,64,128,256,1024), so the
+//divisions by a prescaler are shifts, the CS bits value is the table index + 1
+const uint8_t Gau8_SolveShifts01[]={0,3,6,8,10};
+const uint8_t Gau8_SolveShifts2[]={0,3,5,6,7,8,10};
+
+#define SOLVE_PRESCALERS01_NO    (sizeof(Gau8_SolveShifts01)/sizeof(Gau8_SolveShifts01[0]))
+#define SOLVE_PRESCALERS2_NO     (sizeof(Gau8_SolveShifts2)/sizeof(Gau8_SolveShifts2[0]))
+//largest multiplier that keeps u32Err*1000000 in 32 bits
+#define SOLVE_PPM_ERR_MAX        4294UL
+
+
+/******************** Private Functions ****************************************/
+
+//(achieved-requested)/requested in ppm without 64 bit math, both are scaled down until the
+//product fits, which only drops bits far below the ppm resolution
+static sint32_t TimerSolve_Ppm(uint32_t u32Achieved, uint32_t u32Requested)
+{
+   uint32_t u32Err;
+   uint8_t  u8Late=(u32Achieved >= u32Requested);
+   u32Err=u8Late ? (u32Achieved-u32Requested) : (u32Requested-u32Achieved);
+   while (u32Err > SOLVE_PPM_ERR_MAX)
+   {
+      u32Err>>=1;
+      u32Requested>>=1;
+   }
+   u32Err=(u32Err*1000000UL)/u32Requested;
+   return u8Late ? (sint32_t)u32Err : -(sint32_t)u32Err;
+}
+
+
+/************************************************************************************
+* Parameters (in): enuTimerSolveTimer_t enuTimer, enuTimerSolveMode_t enuMode, uint32_t u32Cycles,
+*                  uint32_t u32Resolution, uint32_t u32MaxCount, strTimerSolution_t* pstrSolution
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (no setting within u32MaxCount)
+* Description: A function to find the timer setting closest to a period of u32Cycles CPU cycles
+*              with at most u32MaxCount compare matches or whole overflows per period
+************************************************************************************/
+enuErrorStatus_t TimerSolve(enuTimerSolveTimer_t enuTimer, enuTimerSolveMode_t enuMode, uint32_t u32Cycles,
+                            uint32_t u32Resolution, uint32_t u32MaxCount, strTimerSolution_t* pstrSolution)
+{
+   const uint8_t* pu8Shifts;
+   uint8_t  u8PrescalersNo;
+   uint8_t  u8TimerBits;
+   uint32_t u32TimerTicks;
+   uint8_t  u8Shift;
+   uint8_t  u8i;
+   uint32_t u32Prescaler;
+   uint32_t u32Count;
+   uint32_t u32CountEnd;
+   uint32_t u32Divisor;
+   uint32_t u32Ticks;
+   uint32_t u32Achieved;
+   uint32_t u32Err;
+   uint32_t u32Interrupts;
+   uint32_t u32BestErr=0xFFFFFFFFUL;
+   uint32_t u32BestInterrupts=0xFFFFFFFFUL;
+   uint8_t  u8Found=0;
+
+   if (pstrSolution == NULLPTR || u32Cycles == 0 || u32Cycles > TIMERSOLVE_MAX_CYCLES
+       || u32Resolution == 0 || u32MaxCount == 0)
+   {
+      return ERROR;
+   }
+   switch (enuTimer)
+   {
+      case TIMERSOLVE_TIMER0:
+      pu8Shifts=Gau8_SolveShifts01;   u8PrescalersNo=SOLVE_PRESCALERS01_NO;   u8TimerBits=8;
+      break;
+      case TIMERSOLVE_TIMER1:
+      pu8Shifts=Gau8_SolveShifts01;   u8PrescalersNo=SOLVE_PRESCALERS01_NO;   u8TimerBits=16;
+      break;
+      case TIMERSOLVE_TIMER2:
+      pu8Shifts=Gau8_SolveShifts2;    u8PrescalersNo=SOLVE_PRESCALERS2_NO;    u8TimerBits=8;
+      break;
+      default:
+      return ERROR;
+      break;
+   }
+
+   u32TimerTicks=1UL<<u8TimerBits;
+   for (u8i=0;u8i<u8PrescalersNo;u8i++)
+   {
+      u8Shift=pu8Shifts[u8i];
+      u32Prescaler=1UL<<u8Shift;
+      if (enuMode == TIMERSOLVE_CTC)
+      {
+         //smallest number of compare matches that fits the period in the timer
+         u32Count=(u32Cycles+(u32Prescaler<<u8TimerBits)-1)>>(u8Shift+u8TimerBits);
+         u32CountEnd=u32Count+TIMERSOLVE_COUNT_SPAN;
+         for (;u32Count<u32CountEnd && u32Count<=u32MaxCount;u32Count++)
+         {
+            //ticks per compare match, rounded to the nearest
+            u32Divisor=u32Count<<u8Shift;
+            u32Ticks=(u32Cycles+(u32Divisor>>1))/u32Divisor;
+            if (u32Ticks == 0)
+            {
+               break;
+            }
+            if (u32Ticks > u32TimerTicks)
+            {
+               u32Ticks=u32TimerTicks;
+            }
+            u32Achieved=(u32Count*u32Ticks)<<u8Shift;
+            u32Err=(u32Achieved > u32Cycles) ? (u32Achieved-u32Cycles) : (u32Cycles-u32Achieved);
+            u32Err/=u32Resolution;
+            u32Interrupts=u32Count;
+            if (u32Err < u32BestErr || (u32Err == u32BestErr && u32Interrupts < u32BestInterrupts))
+            {
+               u32BestErr=u32Err;
+               u32BestInterrupts=u32Interrupts;
+               u8Found=1;
+               pstrSolution->u8Scaler=u8i+1;
+               pstrSolution->u16Prescaler=(uint16_t)u32Prescaler;
+               pstrSolution->u16Top=(uint16_t)(u32Ticks-1);
+               pstrSolution->u32Count=u32Count;
+               pstrSolution->u32Cycles=u32Achieved;
+            }
+         }
+      }
+      else
+      {
+         //any tick count works, whole overflows and the rest in the last one, shifts only
+         u32Ticks=(u32Cycles+(u32Prescaler>>1))>>u8Shift;
+         if (u32Ticks == 0)
+         {
+            u32Ticks=1;
+         }
+         u32Count=u32Ticks>>u8TimerBits;
+         if (u32Count > u32MaxCount)
+         {
+            continue;
+         }
+         u32Achieved=u32Ticks<<u8Shift;
+         u32Err=(u32Achieved > u32Cycles) ? (u32Achieved-u32Cycles) : (u32Cycles-u32Achieved);
+         u32Err/=u32Resolution;
+         //the whole overflows and the partial one if there is one
+         u32Interrupts=u32Count+((u32Ticks&(u32TimerTicks-1)) != 0);
+         if (u32Err < u32BestErr || (u32Err == u32BestErr && u32Interrupts < u32BestInterrupts))
+         {
+            u32BestErr=u32Err;
+            u32BestInterrupts=u32Interrupts;
+            u8Found=1;
+            pstrSolution->u8Scaler=u8i+1;
+            pstrSolution->u16Prescaler=(uint16_t)u32Prescaler;
+            pstrSolution->u16Top=(uint16_t)(u32Ticks&(u32TimerTicks-1));
+            pstrSolution->u32Count=u32Count;
+            pstrSolution->u32Cycles=u32Achieved;
+         }
+      }
+   }
+   if (!u8Found)
+   {
+      return ERROR;
+   }
+   pstrSolution->s32ErrorPpm=TimerSolve_Ppm(pstrSolution->u32Cycles,u32Cycles);
+   return SUCCESS;
+}
@@ -0,0 +1,78 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: TimerSolve.h
+* Description: File containing function prototypes for TimerSolve.c
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __TIMER_SOLVE__
+#define __TIMER_SOLVE__
+
+#include "DataTypes.h"
+#include "Utils.h"
+#include "Register.h"
+#include "Clock.h"
+
+/*
+ * Prescaler and reload solver.
+ * For a period in CPU cycles it tries every prescaler of the selected timer and returns the
+ * setting with the smallest timing error, and of the settings with the same error the one
+ * with the fewest interrupts per period. Errors are compared in units of u32Resolution cycles,
+ * so an error finer than the caller can express (e.g. below 1 us for a delay given in us) does
+ * not cost extra interrupts.
+ *
+ *    TIMERSOLVE_CTC       the period is u32Count compare matches of (u16Top+1) ticks, a timer
+ *                         that triggers hardware (ADC) needs u32MaxCount=1
+ *    TIMERSOLVE_OVERFLOW  normal mode as used by T0_Start: a first partial overflow of u16Top
+ *                         ticks (the timer starts at 256-u16Top, none when u16Top is 0) then
+ *                         u32Count whole overflows, u32Count*256+u16Top ticks in total
+ *
+ * CTC mode tries TIMERSOLVE_COUNT_SPAN counts per prescaler starting from the smallest that
+ * fits, so a solve is at most 7*TIMERSOLVE_COUNT_SPAN 32 bit divisions (~20 ms at 8 MHz with
+ * the default span), it is meant for setup time, not for every restart.
+ * Tools/timer_solve_bench.c sweeps the whole delay range on a host and reports the errors.
+ */
+
+#define TIMERSOLVE_COUNT_SPAN          32
+//largest period the solver accepts, errors are computed as signed 32 bit values
+#define TIMERSOLVE_MAX_CYCLES          0x7FFFFFFFUL
+#define TIMERSOLVE_US_TO_CYCLES(us)    CLOCK_US_TO_CYCLES(us)
+
+typedef enum
+{
+   TIMERSOLVE_TIMER0=0,
+   TIMERSOLVE_TIMER1,
+   TIMERSOLVE_TIMER2
+
+}enuTimerSolveTimer_t;
+
+typedef enum
+{
+   TIMERSOLVE_CTC=0,
+   TIMERSOLVE_OVERFLOW
+
+}enuTimerSolveMode_t;
+
+typedef struct
+{
+   uint8_t  u8Scaler;         //value of the CS bits (the timer's scaler enum) of the prescaler
+   uint16_t u16Prescaler;
+   uint16_t u16Top;           //CTC: compare value, OVERFLOW: ticks of the first partial overflow
+   uint32_t u32Count;         //CTC: compare matches per period, OVERFLOW: whole overflows
+   uint32_t u32Cycles;        //achieved period in CPU cycles
+   sint32_t s32ErrorPpm;      //(achieved-requested)/requested in ppm
+}strTimerSolution_t;
+
+/************************************************************************************
+* Parameters (in): enuTimerSolveTimer_t enuTimer, enuTimerSolveMode_t enuMode, uint32_t u32Cycles,
+*                  uint32_t u32Resolution, uint32_t u32MaxCount, strTimerSolution_t* pstrSolution
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (no setting within u32MaxCount)
+* Description: A function to find the timer setting closest to a period of u32Cycles CPU cycles
+*              with at most u32MaxCount compare matches or whole overflows per period
+************************************************************************************/
+enuErrorStatus_t TimerSolve(enuTimerSolveTimer_t enuTimer, enuTimerSolveMode_t enuMode, uint32_t u32Cycles,
+                            uint32_t u32Resolution, uint32_t u32MaxCount, strTimerSolution_t* pstrSolution);
+
+#endif /* __TIMER_SOLVE__ */
@@ -0,0 +1,236 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: Trace.c
+* Description: File containing the binary event trace functions
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#include "Trace.h"
+#include "STimer.h"
+#include "UART.h"
+
+#define TRACE_MASK            (TRACE_BUFFER_SIZE-1)
+#define TRACE_RECORD_MAX      7        //event, argument and a 5 byte varint
+#define TRACE_VARINT_MORE     0x80
+#define TRACE_HALF_RANGE      0x8000
+#define TRACE_INFO_LENGTH     9
+
+//upper word of the time base, read here directly so a record does not pay for a call
+extern volatile uint16_t Gu16_STimerHigh;
+
+uint8_t  Gau8_TraceBuffer[TRACE_BUFFER_SIZE];
+uint8_t  Gu8_TraceHead=0;
+uint8_t  Gu8_TraceTail=0;
+uint32_t Gu32_TraceLast=0;
+//records dropped from the full ring or while it was frozen, stops at 0xFFFF
+uint16_t Gu16_TraceLost=0;
+volatile uint8_t Gu8_TraceOn=0;
+//dump progress, bytes of the ring sent after the info frame
+uint8_t  Gu8_TraceDumping=0;
+uint8_t  Gu8_TraceInfoSent=0;
+uint8_t  Gu8_TraceDumpSent=0;
+
+
+/******************** Private Functions ****************************************/
+
+//time base read, must be called with interrupts disabled (same as STimer_NowRaw)
+static inline uint32_t Trace_Now(void)
+{
+   uint16_t u16High=Gu16_STimerHigh;
+   uint16_t u16Low=TCNT1_R;
+   if (GET_BIT(TIFR_R,TOV1_B) && u16Low < TRACE_HALF_RANGE)
+   {
+      u16High++;
+   }
+   return ((uint32_t)u16High<<16) | u16Low;
+}
+
+static inline void Trace_CountLost(void)
+{
+   if (Gu16_TraceLost != 0xFFFF)
+   {
+      Gu16_TraceLost++;
+   }
+}
+
+//drop the oldest record, must be called with interrupts disabled
+static void Trace_DropOldest(void)
+{
+   uint8_t u8Tail=(Gu8_TraceTail+2) & TRACE_MASK;
+   //skip the varint up to its last byte
+   while (Gau8_TraceBuffer[u8Tail] & TRACE_VARINT_MORE)
+   {
+      u8Tail=(u8Tail+1) & TRACE_MASK;
+   }
+   Gu8_TraceTail=(u8Tail+1) & TRACE_MASK;
+   Trace_CountLost();
+}
+
+static uint8_t Trace_Used(void)
+{
+   return (uint8_t)(Gu8_TraceHead-Gu8_TraceTail) & TRACE_MASK;
+}
+
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to empty the ring and start recording
+************************************************************************************/
+enuErrorStatus_t Trace_Start(void)
+{
+   uint8_t u8Sreg;
+   ATOMIC_ENTER(u8Sreg);
+   Gu8_TraceHead=0;
+   Gu8_TraceTail=0;
+   Gu16_TraceLost=0;
+   Gu8_TraceDumping=0;
+   Gu32_TraceLast=Trace_Now();
+   Gu8_TraceOn=1;
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop recording, the ring keeps its records
+************************************************************************************/
+enuErrorStatus_t Trace_Stop(void)
+{
+   Gu8_TraceOn=0;
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Event, uint8_t u8Arg
+* Parameters (out): void
+* Return value: void
+* Description: A function to record an event with the current time, called through TRACE()
+************************************************************************************/
+void Trace_Record(uint8_t u8Event, uint8_t u8Arg)
+{
+   uint8_t  u8Sreg;
+   uint8_t  u8Head;
+   uint32_t u32Now;
+   uint32_t u32Delta;
+   ATOMIC_ENTER(u8Sreg);
+   if (Gu8_TraceOn == 0)
+   {
+      //a frozen ring loses the events, a stopped one is not recording at all
+      if (Gu8_TraceDumping)
+      {
+         Trace_CountLost();
+      }
+      ATOMIC_EXIT(u8Sreg);
+      return;
+   }
+   u32Now=Trace_Now();
+   u32Delta=u32Now-Gu32_TraceLast;
+   Gu32_TraceLast=u32Now;
+   //keep room for the longest record
+   while (Trace_Used() > TRACE_BUFFER_SIZE-1-TRACE_RECORD_MAX)
+   {
+      Trace_DropOldest();
+   }
+   u8Head=Gu8_TraceHead;
+   Gau8_TraceBuffer[u8Head]=u8Event;
+   u8Head=(u8Head+1) & TRACE_MASK;
+   Gau8_TraceBuffer[u8Head]=u8Arg;
+   u8Head=(u8Head+1) & TRACE_MASK;
+   //most deltas take one or two bytes, the 16 bit test keeps the 32 bit shifts off that path
+   while ((uint16_t)(u32Delta>>16) != 0 || (uint16_t)u32Delta >= TRACE_VARINT_MORE)
+   {
+      Gau8_TraceBuffer[u8Head]=(uint8_t)u32Delta | TRACE_VARINT_MORE;
+      u8Head=(u8Head+1) & TRACE_MASK;
+      u32Delta>>=7;
+   }
+   Gau8_TraceBuffer[u8Head]=(uint8_t)u32Delta;
+   Gu8_TraceHead=(u8Head+1) & TRACE_MASK;
+   ATOMIC_EXIT(u8Sreg);
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop recording and start sending the ring with Trace_DumpPoll
+************************************************************************************/
+enuErrorStatus_t Trace_DumpStart(void)
+{
+   uint8_t u8Sreg;
+   ATOMIC_ENTER(u8Sreg);
+   Gu8_TraceOn=0;
+   Gu8_TraceDumping=1;
+   Gu8_TraceInfoSent=0;
+   Gu8_TraceDumpSent=0;
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=dump complete or 0=more to send (or no dump started)
+* Description: A function to queue the next dump frame if the UART has room, to be called from
+*              the main loop until it returns SUCCESS, recording then starts again on an empty ring
+************************************************************************************/
+enuErrorStatus_t Trace_DumpPoll(void)
+{
+   uint8_t au8Frame[TRACE_DUMP_CHUNK];
+   uint8_t u8Sreg;
+   uint8_t u8Used;
+   uint8_t u8Length;
+   uint8_t u8i;
+   uint16_t u16Lost;
+   if (Gu8_TraceDumping == 0)
+   {
+      return ERROR;
+   }
+   //the ring is frozen, only the lost count still moves
+   u8Used=Trace_Used();
+   if (Gu8_TraceInfoSent == 0)
+   {
+      ATOMIC_ENTER(u8Sreg);
+      u16Lost=Gu16_TraceLost;
+      ATOMIC_EXIT(u8Sreg);
+      //info: ticks per us, ring bytes, lost records, time of the last record, little endian
+      au8Frame[0]=(uint8_t)STIMER_TICKS_PER_US;
+      au8Frame[1]=u8Used;
+      au8Frame[2]=0;
+      au8Frame[3]=(uint8_t)u16Lost;
+      au8Frame[4]=(uint8_t)(u16Lost>>8);
+      au8Frame[5]=(uint8_t)Gu32_TraceLast;
+      au8Frame[6]=(uint8_t)(Gu32_TraceLast>>8);
+      au8Frame[7]=(uint8_t)(Gu32_TraceLast>>16);
+      au8Frame[8]=(uint8_t)(Gu32_TraceLast>>24);
+      if (UART_SendFrame(UART_FRAME_TRACE_INFO,au8Frame,TRACE_INFO_LENGTH) == SUCCESS)
+      {
+         Gu8_TraceInfoSent=1;
+      }
+      return ERROR;
+   }
+   if (Gu8_TraceDumpSent < u8Used)
+   {
+      u8Length=u8Used-Gu8_TraceDumpSent;
+      if (u8Length > TRACE_DUMP_CHUNK)
+      {
+         u8Length=TRACE_DUMP_CHUNK;
+      }
+      for (u8i=0;u8i<u8Length;u8i++)
+      {
+         au8Frame[u8i]=Gau8_TraceBuffer[(uint8_t)(Gu8_TraceTail+Gu8_TraceDumpSent+u8i) & TRACE_MASK];
+      }
+      if (UART_SendFrame(UART_FRAME_TRACE_DATA,au8Frame,u8Length) == SUCCESS)
+      {
+         Gu8_TraceDumpSent+=u8Length;
+      }
+      return ERROR;
+   }
+   //everything is queued, record again from an empty ring
+   Trace_Start();
+   return SUCCESS;
+}
@@ -0,0 +1,108 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: Trace.h
+* Description: File containing function prototypes for Trace.c
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __TRACE__
+#define __TRACE__
+
+#include "DataTypes.h"
+#include "Utils.h"
+#include "Register.h"
+#include "Atomic.h"
+
+/*
+ * Binary event trace.
+ * Built with TRACE_ENABLE defined, the drivers record their events into a RAM ring (ISR entry
+ * and exit in Vect.c, timer start/stop and callbacks in Timer.c and STimer.c, DIO_Toggle),
+ * without it every TRACE() compiles to nothing. The time stamps are the software timer time
+ * base (timer 1, STimer_Init has to be called) so recording needs no timer of its own.
+ *
+ * A record is the event, one argument byte and the time since the previous record as a
+ * varint (7 bits per byte, low bits first, bit 7 set on all but the last byte):
+ *    events 1 us apart take 3 bytes, 16 ms apart 4 bytes at 1 tick per us
+ * When the ring is full the oldest records are dropped, so it always holds the latest events.
+ * Recording costs ~70 cycles with a 1 byte delta (instruction count estimate of the -Os
+ * output, including the call), interrupts are masked for all of it.
+ *
+ * Trace_DumpStart freezes the ring and Trace_DumpPoll sends it as UART frames a chunk at a
+ * time from the main loop, Tools/trace_decode.c turns a capture of them into a Chrome trace
+ * (chrome://tracing, Perfetto) or a text timeline. Events of the application use
+ * TRACE_EV_USER and up.
+ */
+
+//configuration
+#define TRACE_BUFFER_SIZE        256         //bytes, a power of two up to 256
+#define TRACE_DUMP_CHUNK         32          //payload bytes per dump frame
+
+#if (TRACE_BUFFER_SIZE & (TRACE_BUFFER_SIZE-1)) != 0 || TRACE_BUFFER_SIZE > 256
+#error "Trace: TRACE_BUFFER_SIZE must be a power of two up to 256"
+#endif
+
+//argument of the timer 0 events, software timers pass the low byte of their handle
+#define TRACE_TIMER0             0xFF
+#define TRACE_HANDLE(pv)         ((uint8_t)(__UINTPTR_TYPE__)(pv))
+
+typedef enum
+{
+   TRACE_EV_ISR_ENTER=1,      //argument: enuVect_t
+   TRACE_EV_ISR_EXIT,         //argument: enuVect_t
+   TRACE_EV_TIMER_START,      //argument: timer
+   TRACE_EV_TIMER_STOP,       //argument: timer
+   TRACE_EV_CALLBACK,         //argument: timer
+   TRACE_EV_DIO_TOGGLE,       //argument: enuDIOPinNo_t
+   TRACE_EV_USER=0x10
+
+}enuTraceEvent_t;
+
+#ifdef TRACE_ENABLE
+#define TRACE(enuEvent,u8Arg)    Trace_Record((uint8_t)(enuEvent),(uint8_t)(u8Arg))
+#else
+#define TRACE(enuEvent,u8Arg)    ((void)0)
+#endif
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to empty the ring and start recording
+************************************************************************************/
+enuErrorStatus_t Trace_Start(void);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop recording, the ring keeps its records
+************************************************************************************/
+enuErrorStatus_t Trace_Stop(void);
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Event, uint8_t u8Arg
+* Parameters (out): void
+* Return value: void
+* Description: A function to record an event with the current time, called through TRACE()
+************************************************************************************/
+void Trace_Record(uint8_t u8Event, uint8_t u8Arg);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to stop recording and start sending the ring with Trace_DumpPoll
+************************************************************************************/
+enuErrorStatus_t Trace_DumpStart(void);
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=dump complete or 0=more to send (or no dump started)
+* Description: A function to queue the next dump frame if the UART has room, to be called from
+*              the main loop until it returns SUCCESS, recording then starts again on an empty ring
+************************************************************************************/
+enuErrorStatus_t Trace_DumpPoll(void);
+
+#endif /* __TRACE__ */
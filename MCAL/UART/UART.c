@@ -0,0 +1,226 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: UART.c
+* Description: File containing the interrupt driven UART driver functions
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#include "UART.h"
+
+//transmit ring: filled by the main loop, drained by the UDRE ISR
+RING_DEFINE(UartTxRing,uint8_t,UART_TX_BUFFER_SIZE)
+strUartTxRing_t Gstr_UartTxRing;
+
+//receive ring: filled by the RX ISR, drained by the main loop
+RING_DEFINE(UartRxRing,uint8_t,UART_RX_BUFFER_SIZE)
+strUartRxRing_t Gstr_UartRxRing;
+volatile uint8_t Gu8_UartRxOverruns=0;
+
+
+/******************** Private Functions ****************************************/
+
+//write a byte into the u8Slot-th free slot of the transmit ring, the caller has checked the room
+static void UART_TxPut(uint8_t* pu8Slot, uint8_t u8Data)
+{
+   *UartTxRing_Slot(&Gstr_UartTxRing,*pu8Slot)=u8Data;
+   (*pu8Slot)++;
+}
+
+//publish the filled slots and make sure the UDRE interrupt drains the ring
+static void UART_TxCommit(uint8_t u8Count)
+{
+   UartTxRing_Commit(&Gstr_UartTxRing,u8Count);
+   SET_BIT(UCSRB_R,UDRIE_B);
+}
+
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to initialize the UART at UART_BAUD 8N1 with both interrupts enabled
+************************************************************************************/
+enuErrorStatus_t UART_Init(void)
+{
+   //disable the UART while configuring
+   UCSRB_R=0;
+   UartTxRing_Init(&Gstr_UartTxRing);
+   UartRxRing_Init(&Gstr_UartRxRing);
+   Gu8_UartRxOverruns=0;
+
+   //baud rate from the compile time divider
+   UBRRH_R=(uint8_t)(UART_UBRR>>8);
+   UBRRL_R=(uint8_t)UART_UBRR;
+#if UART_USE_U2X
+   UCSRA_R=(1<<U2X_B);
+#else
+   UCSRA_R=0;
+#endif
+   //asynchronous, 8 data bits, no parity, 1 stop bit
+   UCSRC_R=(1<<URSEL_B) | (1<<UCSZ1_B) | (1<<UCSZ0_B);
+   //enable the receiver, transmitter and the receive interrupt, UDRIE is set when data is queued
+   UCSRB_R=(1<<RXEN_B) | (1<<TXEN_B) | (1<<RXCIE_B);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Data
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (transmit buffer full)
+* Description: A function to queue one byte for transmission without blocking
+************************************************************************************/
+enuErrorStatus_t UART_SendByte(uint8_t u8Data)
+{
+   if (UartTxRing_Push(&Gstr_UartTxRing,u8Data) == ERROR)
+   {
+      return ERROR;
+   }
+   SET_BIT(UCSRB_R,UDRIE_B);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): const uint8_t* pu8Data, uint8_t u8Length
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (not enough room, nothing queued)
+* Description: A function to queue a block of bytes for transmission without blocking
+************************************************************************************/
+enuErrorStatus_t UART_Send(const uint8_t* pu8Data, uint8_t u8Length)
+{
+   if (pu8Data == NULLPTR || UartTxRing_PushBlock(&Gstr_UartTxRing,pu8Data,u8Length) == ERROR)
+   {
+      return ERROR;
+   }
+   SET_BIT(UCSRB_R,UDRIE_B);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Type, const uint8_t* pu8Payload, uint8_t u8Length
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (not enough room, nothing queued)
+* Description: A function to queue a framed binary packet for the host decoder
+************************************************************************************/
+enuErrorStatus_t UART_SendFrame(uint8_t u8Type, const uint8_t* pu8Payload, uint8_t u8Length)
+{
+   uint8_t u8Slot=0;
+   uint8_t u8CkA,u8CkB;
+   uint8_t u8i;
+   if ((pu8Payload == NULLPTR && u8Length != 0) || UartTxRing_Free(&Gstr_UartTxRing) < (uint16_t)u8Length+UART_FRAME_OVERHEAD)
+   {
+      return ERROR;
+   }
+   UART_TxPut(&u8Slot,UART_FRAME_SYNC1);
+   UART_TxPut(&u8Slot,UART_FRAME_SYNC2);
+   UART_TxPut(&u8Slot,u8Type);
+   UART_TxPut(&u8Slot,u8Length);
+   //8 bit Fletcher checksum over type, length and payload
+   u8CkA=u8Type;
+   u8CkB=u8CkA;
+   u8CkA+=u8Length;
+   u8CkB+=u8CkA;
+   for (u8i=0;u8i<u8Length;u8i++)
+   {
+      UART_TxPut(&u8Slot,pu8Payload[u8i]);
+      u8CkA+=pu8Payload[u8i];
+      u8CkB+=u8CkA;
+   }
+   UART_TxPut(&u8Slot,u8CkA);
+   UART_TxPut(&u8Slot,u8CkB);
+   //publish the whole frame at once so the ISR never sends half of it
+   UART_TxCommit(u8Slot);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t* pu8Data
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (nothing received)
+* Description: A function to take one received byte without blocking
+************************************************************************************/
+enuErrorStatus_t UART_ReceiveByte(uint8_t* pu8Data)
+{
+   if (pu8Data == NULLPTR)
+   {
+      return ERROR;
+   }
+   return UartRxRing_Pop(&Gstr_UartRxRing,pu8Data);
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t* pu8Free
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read how many bytes can be queued for transmission right now
+************************************************************************************/
+enuErrorStatus_t UART_GetTxFree(uint8_t* pu8Free)
+{
+   if (pu8Free == NULLPTR)
+   {
+      return ERROR;
+   }
+   *pu8Free=UartTxRing_Free(&Gstr_UartTxRing);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t* pu8Overruns
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the number of received bytes lost to a full buffer or a hardware overrun
+************************************************************************************/
+enuErrorStatus_t UART_GetRxOverruns(uint8_t* pu8Overruns)
+{
+   if (pu8Overruns == NULLPTR)
+   {
+      return ERROR;
+   }
+   *pu8Overruns=Gu8_UartRxOverruns;
+   return SUCCESS;
+}
+
+
+/******************** Interrupt Handlers ****************************************/
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Data register empty handler, sends the next byte of the transmit ring
+************************************************************************************/
+void UART_UDREHandler(void* pvCtx)
+{
+   uint8_t u8Data;
+   if (UartTxRing_Pop(&Gstr_UartTxRing,&u8Data) == SUCCESS)
+   {
+      UDR_R=u8Data;
+   }
+   else
+   {
+      //nothing left to send, stop the interrupt until new data is queued
+      CLR_BIT(UCSRB_R,UDRIE_B);
+   }
+}
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Receive complete handler, stores the received byte in the receive ring
+************************************************************************************/
+void UART_RXHandler(void* pvCtx)
+{
+   uint8_t u8Data;
+   //the data overrun flag has to be read before UDR
+   if (GET_BIT(UCSRA_R,DOR_B))
+   {
+      Gu8_UartRxOverruns++;
+   }
+   //reading UDR clears the interrupt even if the byte is dropped
+   u8Data=UDR_R;
+   if (UartRxRing_Push(&Gstr_UartRxRing,u8Data) == ERROR)
+   {
+      Gu8_UartRxOverruns++;
+   }
+}
@@ -0,0 +1,165 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: UART.h
+* Description: File containing function prototypes for UART.c
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __UART__
+#define __UART__
+
+#include "DataTypes.h"
+#include "Utils.h"
+#include "Register.h"
+#include "Ring.h"
+
+/*
+ * Interrupt driven UART, 8N1.
+ * Transmission is fed from a ring buffer by the data register empty interrupt and reception
+ * fills a ring buffer from the receive complete interrupt. Both are Ring.h rings, one producer
+ * and one consumer with 8 bit indices, so no side has to mask interrupts to move data.
+ *
+ * Framed mode wraps a payload as: 0xA5 0x5A type length payload[length] ckA ckB
+ * where ckA/ckB is an 8 bit Fletcher checksum over type, length and payload.
+ * Tools/uart_decode.c decodes the stream on a Linux host.
+ */
+
+//configuration
+#ifndef UART_BAUD
+//below 4 MHz 38400 baud is off by more than 2%, 9600 is within 0.2% at 1 and 2 MHz
+#if F_CPU >= 4000000UL
+#define UART_BAUD                38400UL
+#else
+#define UART_BAUD                9600UL
+#endif
+#endif
+//buffer sizes, powers of two up to 128
+#define UART_TX_BUFFER_SIZE      64
+#define UART_RX_BUFFER_SIZE      32
+
+#if (UART_TX_BUFFER_SIZE & (UART_TX_BUFFER_SIZE-1)) != 0 || UART_TX_BUFFER_SIZE > 128
+#error "UART: UART_TX_BUFFER_SIZE must be a power of two up to 128"
+#endif
+#if (UART_RX_BUFFER_SIZE & (UART_RX_BUFFER_SIZE-1)) != 0 || UART_RX_BUFFER_SIZE > 128
+#error "UART: UART_RX_BUFFER_SIZE must be a power of two up to 128"
+#endif
+
+//baud rate register values for normal and double speed, rounded to the nearest divider
+#define UART_ABS_DIFF(a,b)       ((a)>(b) ? (a)-(b) : (b)-(a))
+#if (F_CPU/(8UL*UART_BAUD)) == 0
+#error "UART: UART_BAUD is too high for F_CPU"
+#endif
+#define UART_UBRR_U2X            (((F_CPU+4UL*UART_BAUD)/(8UL*UART_BAUD))-1)
+#define UART_REAL_U2X            (F_CPU/(8UL*(UART_UBRR_U2X+1)))
+#if (F_CPU/(16UL*UART_BAUD)) == 0
+#define UART_USE_U2X             1
+#else
+#define UART_UBRR_1X             (((F_CPU+8UL*UART_BAUD)/(16UL*UART_BAUD))-1)
+#define UART_REAL_1X             (F_CPU/(16UL*(UART_UBRR_1X+1)))
+//double speed only when it is strictly more accurate, it halves the receiver sampling
+#if UART_ABS_DIFF(UART_REAL_U2X,UART_BAUD) < UART_ABS_DIFF(UART_REAL_1X,UART_BAUD)
+#define UART_USE_U2X             1
+#else
+#define UART_USE_U2X             0
+#endif
+#endif
+
+#if UART_USE_U2X
+#define UART_UBRR                UART_UBRR_U2X
+#define UART_REAL_BAUD           UART_REAL_U2X
+#else
+#define UART_UBRR                UART_UBRR_1X
+#define UART_REAL_BAUD           UART_REAL_1X
+#endif
+
+#if (UART_ABS_DIFF(UART_REAL_BAUD,UART_BAUD)*1000UL)/UART_BAUD > 20
+#error "UART: baud rate error above 2% for this F_CPU"
+#endif
+
+//frame format
+#define UART_FRAME_SYNC1         0xA5
+#define UART_FRAME_SYNC2         0x5A
+#define UART_FRAME_OVERHEAD      6
+
+//frame types used by the drivers, applications may use 0x80 and above
+#define UART_FRAME_TEXT          0x01
+#define UART_FRAME_TIMER_STATS   0x10
+#define UART_FRAME_CAPTURE       0x11
+#define UART_FRAME_TRACE_INFO    0x12
+#define UART_FRAME_TRACE_DATA    0x13
+
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to initialize the UART at UART_BAUD 8N1 with both interrupts enabled
+************************************************************************************/
+enuErrorStatus_t UART_Init(void);
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Data
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (transmit buffer full)
+* Description: A function to queue one byte for transmission without blocking
+************************************************************************************/
+enuErrorStatus_t UART_SendByte(uint8_t u8Data);
+
+/************************************************************************************
+* Parameters (in): const uint8_t* pu8Data, uint8_t u8Length
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (not enough room, nothing queued)
+* Description: A function to queue a block of bytes for transmission without blocking
+************************************************************************************/
+enuErrorStatus_t UART_Send(const uint8_t* pu8Data, uint8_t u8Length);
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Type, const uint8_t* pu8Payload, uint8_t u8Length
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (not enough room, nothing queued)
+* Description: A function to queue a framed binary packet for the host decoder
+************************************************************************************/
+enuErrorStatus_t UART_SendFrame(uint8_t u8Type, const uint8_t* pu8Payload, uint8_t u8Length);
+
+/************************************************************************************
+* Parameters (in): uint8_t* pu8Data
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (nothing received)
+* Description: A function to take one received byte without blocking
+************************************************************************************/
+enuErrorStatus_t UART_ReceiveByte(uint8_t* pu8Data);
+
+/************************************************************************************
+* Parameters (in): uint8_t* pu8Free
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read how many bytes can be queued for transmission right now
+************************************************************************************/
+enuErrorStatus_t UART_GetTxFree(uint8_t* pu8Free);
+
+/************************************************************************************
+* Parameters (in): uint8_t* pu8Overruns
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the number of received bytes lost to a full buffer or a hardware overrun
+************************************************************************************/
+enuErrorStatus_t UART_GetRxOverruns(uint8_t* pu8Overruns);
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Data register empty handler, sends the next byte of the transmit ring
+************************************************************************************/
+void UART_UDREHandler(void* pvCtx);
+
+/************************************************************************************
+* Parameters (in): void* pvCtx
+* Parameters (out): void
+* Return value: void
+* Description: Receive complete handler, stores the received byte in the receive ring
+************************************************************************************/
+void UART_RXHandler(void* pvCtx);
+
+#endif /* __UART__ */
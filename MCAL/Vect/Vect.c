@@ -0,0 +1,209 @@
+/*****************************************************************************
+* Task: AVR_DRIVERS
+* File Name: Vect.c
+* Description: File containing the interrupt vector dispatch functions and ISRs
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#include "Vect.h"
+#include "Trace.h"
+
+#if VECT_OVERRIDE_SLOTS > 8
+#error "Vect: the used slots are kept in one byte, VECT_OVERRIDE_SLOTS can not exceed 8"
+#endif
+
+#define VECT_NO_SLOT    0xFF
+
+//bit per vector number, set if Vect.c defines its ISR
+#define VECT_DISPATCHED_MASK  (((uint32_t)VECT_USE_INT0<<VECT_INT0)                 \
+                              |((uint32_t)VECT_USE_INT1<<VECT_INT1)                 \
+                              |((uint32_t)VECT_USE_INT2<<VECT_INT2)                 \
+                              |((uint32_t)VECT_USE_TIMER2_COMP<<VECT_TIMER2_COMP)   \
+                              |((uint32_t)VECT_USE_TIMER2_OVF<<VECT_TIMER2_OVF)     \
+                              |((uint32_t)VECT_USE_TIMER1_ICU<<VECT_TIMER1_ICU)     \
+                              |((uint32_t)VECT_USE_TIMER1_OCA<<VECT_TIMER1_OCA)     \
+                              |((uint32_t)VECT_USE_TIMER1_OCB<<VECT_TIMER1_OCB)     \
+                              |((uint32_t)VECT_USE_TIMER1_OVF<<VECT_TIMER1_OVF)     \
+                              |((uint32_t)VECT_USE_TIMER0_OC<<VECT_TIMER0_OC)       \
+                              |((uint32_t)VECT_USE_TIMER0_OVF<<VECT_TIMER0_OVF)     \
+                              |((uint32_t)VECT_USE_SPI_STC<<VECT_SPI_STC)           \
+                              |((uint32_t)VECT_USE_UART_RX<<VECT_UART_RX)           \
+                              |((uint32_t)VECT_USE_UART_UDRE<<VECT_UART_UDRE)       \
+                              |((uint32_t)VECT_USE_UART_TX<<VECT_UART_TX)           \
+                              |((uint32_t)VECT_USE_ADC<<VECT_ADC)                   \
+                              |((uint32_t)VECT_USE_EE_RDY<<VECT_EE_RDY)             \
+                              |((uint32_t)VECT_USE_ANA_COMP<<VECT_ANA_COMP)         \
+                              |((uint32_t)VECT_USE_TWI<<VECT_TWI)                   \
+                              |((uint32_t)VECT_USE_SPM_RDY<<VECT_SPM_RDY))
+
+//override slot of each vector or VECT_NO_SLOT to use the default handler
+volatile uint8_t Gau8_VectSlot[VECT_NO]={[0 ... VECT_NO-1]=VECT_NO_SLOT};
+strVectEntry_t   Gastr_VectOverrides[VECT_OVERRIDE_SLOTS];
+uint8_t          Gu8_VectSlotsUsed=0;
+
+
+/******************** Private Functions ****************************************/
+
+//call the handler of a vector, inlined in every ISR
+static inline void Vect_Dispatch(enuVect_t enuVect)
+{
+   pfVectHandler_t pfHandler;
+   void*           pvCtx;
+   uint8_t u8Slot=Gau8_VectSlot[enuVect];
+   if (u8Slot == VECT_NO_SLOT)
+   {
+      pfHandler=Gastr_VectDefaults[enuVect].pfHandler;
+      pvCtx=Gastr_VectDefaults[enuVect].pvCtx;
+   }
+   else
+   {
+      pfHandler=Gastr_VectOverrides[u8Slot].pfHandler;
+      pvCtx=Gastr_VectOverrides[u8Slot].pvCtx;
+   }
+   if (pfHandler != NULLPTR)
+   {
+      pfHandler(pvCtx);
+   }
+}
+
+
+/************************************************************************************
+* Parameters (in): enuVect_t enuVect, pfVectHandler_t pfHandler, void* pvCtx
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to make pfHandler(pvCtx) the handler of enuVect instead of its default,
+*              fails if the vector is not dispatched by Vect.c or all override slots are taken
+************************************************************************************/
+enuErrorStatus_t Vect_Register(enuVect_t enuVect, pfVectHandler_t pfHandler, void* pvCtx)
+{
+   enuErrorStatus_t enuStatus=SUCCESS;
+   uint8_t u8Sreg;
+   uint8_t u8Slot;
+   uint8_t u8i;
+   if (enuVect >= VECT_NO || pfHandler == NULLPTR || !(VECT_DISPATCHED_MASK & ((uint32_t)1<<enuVect)))
+   {
+      return ERROR;
+   }
+   //the ISR must never see the new handler with the old context
+   ATOMIC_ENTER(u8Sreg);
+   u8Slot=Gau8_VectSlot[enuVect];
+   //take a free slot if the vector has none yet
+   if (u8Slot == VECT_NO_SLOT)
+   {
+      for (u8i=0;u8i<VECT_OVERRIDE_SLOTS;u8i++)
+      {
+         if (!GET_BIT(Gu8_VectSlotsUsed,u8i))
+         {
+            u8Slot=u8i;
+            break;
+         }
+      }
+   }
+   if (u8Slot == VECT_NO_SLOT)
+   {
+      enuStatus=ERROR;
+   }
+   else
+   {
+      Gastr_VectOverrides[u8Slot].pfHandler=pfHandler;
+      Gastr_VectOverrides[u8Slot].pvCtx=pvCtx;
+      SET_BIT(Gu8_VectSlotsUsed,u8Slot);
+      Gau8_VectSlot[enuVect]=u8Slot;
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return enuStatus;
+}
+
+/************************************************************************************
+* Parameters (in): enuVect_t enuVect
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to give enuVect back to its default handler and free its override slot
+************************************************************************************/
+enuErrorStatus_t Vect_Restore(enuVect_t enuVect)
+{
+   uint8_t u8Sreg;
+   uint8_t u8Slot;
+   if (enuVect >= VECT_NO)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   u8Slot=Gau8_VectSlot[enuVect];
+   if (u8Slot != VECT_NO_SLOT)
+   {
+      Gau8_VectSlot[enuVect]=VECT_NO_SLOT;
+      CLR_BIT(Gu8_VectSlotsUsed,u8Slot);
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+
+/******************** ISR FUNCTIONS ****************************************/
+
+//with TRACE_ENABLE every dispatched interrupt is recorded around its handler
+#define VECT_ISR(vector,enuVect)    ISR(vector) { TRACE(TRACE_EV_ISR_ENTER,enuVect); Vect_Dispatch(enuVect); \
+                                                  TRACE(TRACE_EV_ISR_EXIT,enuVect); }
+
+#if VECT_USE_INT0
+VECT_ISR(INT0_vect,VECT_INT0)
+#endif
+#if VECT_USE_INT1
+VECT_ISR(INT1_vect,VECT_INT1)
+#endif
+#if VECT_USE_INT2
+VECT_ISR(INT2_vect,VECT_INT2)
+#endif
+#if VECT_USE_TIMER2_COMP
+VECT_ISR(TIMER2_COMP_vect,VECT_TIMER2_COMP)
+#endif
+#if VECT_USE_TIMER2_OVF
+VECT_ISR(TIMER2_OVF_vect,VECT_TIMER2_OVF)
+#endif
+#if VECT_USE_TIMER1_ICU
+VECT_ISR(TIMER1_ICU_vect,VECT_TIMER1_ICU)
+#endif
+#if VECT_USE_TIMER1_OCA
+VECT_ISR(TIMER1_OCA_vect,VECT_TIMER1_OCA)
+#endif
+#if VECT_USE_TIMER1_OCB
+VECT_ISR(TIMER1_OCB_vect,VECT_TIMER1_OCB)
+#endif
+#if VECT_USE_TIMER1_OVF
+VECT_ISR(TIMER1_OVF_vect,VECT_TIMER1_OVF)
+#endif
+#if VECT_USE_TIMER0_OC
+VECT_ISR(TIMER0_OC_vect,VECT_TIMER0_OC)
+#endif
+#if VECT_USE_TIMER0_OVF
+VECT_ISR(TIMER0_OVF_vect,VECT_TIMER0_OVF)
+#endif
+#if VECT_USE_SPI_STC
+VECT_ISR(SPI_STC_vect,VECT_SPI_STC)
+#endif
+#if VECT_USE_UART_RX
+VECT_ISR(UART_RX_vect,VECT_UART_RX)
+#endif
+#if VECT_USE_UART_UDRE
+VECT_ISR(UART_UDRE_vect,VECT_UART_UDRE)
+#endif
+#if VECT_USE_UART_TX
+VECT_ISR(UART_TX_vect,VECT_UART_TX)
+#endif
+#if VECT_USE_ADC
+VECT_ISR(ADC_vect,VECT_ADC)
+#endif
+#if VECT_USE_EE_RDY
+VECT_ISR(EE_RDY_vect,VECT_EE_RDY)
+#endif
+#if VECT_USE_ANA_COMP
+VECT_ISR(ANA_COMP_vect,VECT_ANA_COMP)
+#endif
+#if VECT_USE_TWI
+VECT_ISR(TWI_vect,VECT_TWI)
+#endif
+#if VECT_USE_SPM_RDY
+VECT_ISR(SPM_RDY_vect,VECT_SPM_RDY)
+#endif
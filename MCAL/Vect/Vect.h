@@ -0,0 +1,86 @@
+/*****************************************************************************
+* Task: AVR_DRIVERS
+* File Name: Vect.h
+* Description: File containing function prototypes for Vect.c
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __VECT__
+#define __VECT__
+
+#include "DataTypes.h"
+#include "Utils.h"
+#include "Register.h"
+#include "Atomic.h"
+#include "Vect_Cfg.h"
+
+/*
+ * Interrupt vector dispatch.
+ * Vect.c defines the ISRs selected in Vect_Cfg.h. Each one calls the handler registered at run
+ * time for its vector if there is one, else the default handler from the flash table in
+ * Vect_Cfg.c (drivers export their interrupt code as handlers for that table).
+ *
+ * The RAM side is one slot index per vector and VECT_OVERRIDE_SLOTS handler/context pairs.
+ * The lookup adds ~12 cycles to the ISR (slot index, branch, two pointer loads and the icall),
+ * and since the handler is called out of line the ISR saves all call clobbered registers,
+ * ~30 more cycles than a direct ISR with a small leaf body. Vectors that can not afford that
+ * are left to their driver in Vect_Cfg.h.
+ */
+
+typedef void (*pfVectHandler_t)(void* pvCtx);
+
+//vector numbers, same as the __vector_n numbers in Register.h
+typedef enum
+{
+   VECT_INT0=1,
+   VECT_INT1,
+   VECT_INT2,
+   VECT_TIMER2_COMP,
+   VECT_TIMER2_OVF,
+   VECT_TIMER1_ICU,
+   VECT_TIMER1_OCA,
+   VECT_TIMER1_OCB,
+   VECT_TIMER1_OVF,
+   VECT_TIMER0_OC,
+   VECT_TIMER0_OVF,
+   VECT_SPI_STC,
+   VECT_UART_RX,
+   VECT_UART_UDRE,
+   VECT_UART_TX,
+   VECT_ADC,
+   VECT_EE_RDY,
+   VECT_ANA_COMP,
+   VECT_TWI,
+   VECT_SPM_RDY,
+   VECT_NO
+
+}enuVect_t;
+
+typedef struct
+{
+   pfVectHandler_t pfHandler;
+   void*           pvCtx;
+}strVectEntry_t;
+
+//default handlers, indexed by enuVect_t, defined in Vect_Cfg.c
+extern const __flash strVectEntry_t Gastr_VectDefaults[VECT_NO];
+
+/************************************************************************************
+* Parameters (in): enuVect_t enuVect, pfVectHandler_t pfHandler, void* pvCtx
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to make pfHandler(pvCtx) the handler of enuVect instead of its default,
+*              fails if the vector is not dispatched by Vect.c or all override slots are taken
+************************************************************************************/
+enuErrorStatus_t Vect_Register(enuVect_t enuVect, pfVectHandler_t pfHandler, void* pvCtx);
+
+/************************************************************************************
+* Parameters (in): enuVect_t enuVect
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to give enuVect back to its default handler and free its override slot
+************************************************************************************/
+enuErrorStatus_t Vect_Restore(enuVect_t enuVect);
+
+#endif /* __VECT__ */
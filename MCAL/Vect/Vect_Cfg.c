@@ -0,0 +1,33 @@
+/*****************************************************************************
+* Task: AVR_DRIVERS
+* File Name: Vect_Cfg.c
+* Description: configuration File for the interrupt vector dispatch
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#include "Vect.h"
+#include "Timer.h"
+#include "Counter.h"
+#include "UART.h"
+#include "ADC.h"
+#include "STimer.h"
+#include "SPI.h"
+#include "EEPROM.h"
+
+//default handler and context of each vector, used while no handler is registered at run time
+const __flash strVectEntry_t Gastr_VectDefaults[VECT_NO] =
+{
+   [VECT_TIMER2_COMP]   ={Counter_GateHandler,NULLPTR},     /* frequency meter gate */
+   [VECT_TIMER1_OCA]    ={STimer_CompareHandler,NULLPTR},   /* software timers */
+   [VECT_TIMER1_OVF]    ={STimer_OVFHandler,NULLPTR},       /* software timer time base */
+   [VECT_TIMER0_OC]     ={Counter_OCHandler,NULLPTR},       /* event counter threshold */
+#ifndef T0_FAST_TICK
+   [VECT_TIMER0_OVF]    ={T0_OVFHandler,NULLPTR},           /* delays and the T0_OVHookSet hook */
+#endif
+   [VECT_SPI_STC]       ={SPI_STCHandler,NULLPTR},          /* background transfers */
+   [VECT_UART_RX]       ={UART_RXHandler,NULLPTR},
+   [VECT_UART_UDRE]     ={UART_UDREHandler,NULLPTR},
+   [VECT_ADC]           ={ADC_Handler,NULLPTR},             /* timer triggered sampling */
+   [VECT_EE_RDY]        ={EEPROM_RDYHandler,NULLPTR}        /* write queue */
+};
@@ -0,0 +1,53 @@
+/*****************************************************************************
+* Task: AVR_DRIVERS
+* File Name: Vect_Cfg.h
+* Description: configuration File for the interrupt vector dispatch
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __VECT_CFG__
+#define __VECT_CFG__
+
+//number of vectors that can have a handler registered at run time at the same time
+#define VECT_OVERRIDE_SLOTS      4
+
+/*
+ * 1 = the ISR is defined in Vect.c and dispatches through the handler tables
+ * 0 = a driver defines the ISR directly (hot paths that can not afford the dispatch),
+ *     Vect_Register fails for these vectors
+ */
+#define VECT_USE_INT0            0     //Encoder.c
+#define VECT_USE_INT1            0     //Encoder.c
+#define VECT_USE_INT2            1
+#ifdef KERNEL_ENABLE
+#define VECT_USE_TIMER2_COMP     0     //naked kernel tick ISR in Kernel.c
+#else
+#define VECT_USE_TIMER2_COMP     1
+#endif
+#ifdef DDS_ENABLE
+#define VECT_USE_TIMER2_OVF      0     //DDS sample ISR in DDS.c
+#else
+#define VECT_USE_TIMER2_OVF      1
+#endif
+#define VECT_USE_TIMER1_ICU      1
+#define VECT_USE_TIMER1_OCA      1
+#define VECT_USE_TIMER1_OCB      1
+#define VECT_USE_TIMER1_OVF      1
+#define VECT_USE_TIMER0_OC       1
+#ifdef T0_FAST_TICK
+#define VECT_USE_TIMER0_OVF      0     //naked fast tick ISR in Timer.c
+#else
+#define VECT_USE_TIMER0_OVF      1
+#endif
+#define VECT_USE_SPI_STC         1
+#define VECT_USE_UART_RX         1
+#define VECT_USE_UART_UDRE       1
+#define VECT_USE_UART_TX         1
+#define VECT_USE_ADC             1
+#define VECT_USE_EE_RDY          1
+#define VECT_USE_ANA_COMP        1
+#define VECT_USE_TWI             1
+#define VECT_USE_SPM_RDY         1
+
+#endif /* __VECT_CFG__ */
@@ -0,0 +1,777 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: Kernel.c
+* Description: File containing the preemptive kernel functions
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#include "Kernel.h"
+
+#ifdef KERNEL_ENABLE
+
+#define KERNEL_IDLE              KERNEL_TASKS_MAX    //index of the idle task (main)
+#define KERNEL_STACK_PAINT       0xA5
+#define KERNEL_FOREVER_TICKS     0xFFFF
+
+typedef enum
+{
+   KERNEL_READY=0,
+   KERNEL_BLOCKED,
+   KERNEL_DEAD
+
+}enuKernelState_t;
+
+typedef struct
+{
+   uint16_t u16Sp;                  //saved stack pointer, first member: the assembly stores it here
+   uint8_t* pu8Stack;
+   uint16_t u16StackSize;
+   volatile uint16_t u16Timeout;    //ticks left of a blocking call, KERNEL_FOREVER_TICKS for none
+   volatile uint8_t* pu8WaitList;   //waiter bits the task is in while blocked
+   uint8_t  u8Priority;
+   volatile uint8_t u8State;
+   volatile uint8_t u8Woken;        //1 if a give or send ended the block, 0 if the timeout did
+}strKernelTask_t;
+
+strKernelTask_t Gastr_KernelTasks[KERNEL_TASKS_MAX+1];
+//running task, read by the assembly of the context switch
+strKernelTask_t* volatile Gpstr_KernelCurrent=&Gastr_KernelTasks[KERNEL_IDLE];
+volatile uint8_t Gu8_KernelCurrent=KERNEL_IDLE;
+uint8_t  Gu8_KernelTaskCount=0;
+uint8_t  Gu8_KernelStarted=0;
+volatile uint32_t Gu32_KernelTicks=0;
+volatile uint32_t Gu32_KernelSwitches=0;
+
+//save r0-r31 and SREG on the running stack, then the stack pointer in the TCB
+#define KERNEL_SAVE_CONTEXT                              \
+      "push r0                      \n\t"                \
+      "in   r0,%[sreg]              \n\t"                \
+      "cli                          \n\t"                \
+      "push r0                      \n\t"                \
+      "push r1                      \n\t"                \
+      "clr  r1                      \n\t"                \
+      "push r2                      \n\t"                \
+      "push r3                      \n\t"                \
+      "push r4                      \n\t"                \
+      "push r5                      \n\t"                \
+      "push r6                      \n\t"                \
+      "push r7                      \n\t"                \
+      "push r8                      \n\t"                \
+      "push r9                      \n\t"                \
+      "push r10                     \n\t"                \
+      "push r11                     \n\t"                \
+      "push r12                     \n\t"                \
+      "push r13                     \n\t"                \
+      "push r14                     \n\t"                \
+      "push r15                     \n\t"                \
+      "push r16                     \n\t"                \
+      "push r17                     \n\t"                \
+      "push r18                     \n\t"                \
+      "push r19                     \n\t"                \
+      "push r20                     \n\t"                \
+      "push r21                     \n\t"                \
+      "push r22                     \n\t"                \
+      "push r23                     \n\t"                \
+      "push r24                     \n\t"                \
+      "push r25                     \n\t"                \
+      "push r26                     \n\t"                \
+      "push r27                     \n\t"                \
+      "push r28                     \n\t"                \
+      "push r29                     \n\t"                \
+      "push r30                     \n\t"                \
+      "push r31                     \n\t"                \
+      "lds  r26,Gpstr_KernelCurrent \n\t"                \
+      "lds  r27,Gpstr_KernelCurrent+1 \n\t"              \
+      "in   r0,%[spl]               \n\t"                \
+      "st   x+,r0                   \n\t"                \
+      "in   r0,%[sph]               \n\t"                \
+      "st   x+,r0                   \n\t"
+
+//load the stack pointer of the (new) running task and pop what KERNEL_SAVE_CONTEXT pushed
+#define KERNEL_RESTORE_CONTEXT                           \
+      "lds  r26,Gpstr_KernelCurrent \n\t"                \
+      "lds  r27,Gpstr_KernelCurrent+1 \n\t"              \
+      "ld   r28,x+                  \n\t"                \
+      "out  %[spl],r28              \n\t"                \
+      "ld   r29,x+                  \n\t"                \
+      "out  %[sph],r29              \n\t"                \
+      "pop  r31                     \n\t"                \
+      "pop  r30                     \n\t"                \
+      "pop  r29                     \n\t"                \
+      "pop  r28                     \n\t"                \
+      "pop  r27                     \n\t"                \
+      "pop  r26                     \n\t"                \
+      "pop  r25                     \n\t"                \
+      "pop  r24                     \n\t"                \
+      "pop  r23                     \n\t"                \
+      "pop  r22                     \n\t"                \
+      "pop  r21                     \n\t"                \
+      "pop  r20                     \n\t"                \
+      "pop  r19                     \n\t"                \
+      "pop  r18                     \n\t"                \
+      "pop  r17                     \n\t"                \
+      "pop  r16                     \n\t"                \
+      "pop  r15                     \n\t"                \
+      "pop  r14                     \n\t"                \
+      "pop  r13                     \n\t"                \
+      "pop  r12                     \n\t"                \
+      "pop  r11                     \n\t"                \
+      "pop  r10                     \n\t"                \
+      "pop  r9                      \n\t"                \
+      "pop  r8                      \n\t"                \
+      "pop  r7                      \n\t"                \
+      "pop  r6                      \n\t"                \
+      "pop  r5                      \n\t"                \
+      "pop  r4                      \n\t"                \
+      "pop  r3                      \n\t"                \
+      "pop  r2                      \n\t"                \
+      "pop  r1                      \n\t"                \
+      "pop  r0                      \n\t"                \
+      "out  %[sreg],r0              \n\t"                \
+      "pop  r0                      \n\t"
+
+
+/******************** Private Functions ****************************************/
+
+//milliseconds to ticks, KERNEL_WAIT_FOREVER stays forever
+static uint16_t Kernel_Ticks(uint16_t u16Ms)
+{
+   if (u16Ms == KERNEL_WAIT_FOREVER)
+   {
+      return KERNEL_FOREVER_TICKS;
+   }
+   if (u16Ms > KERNEL_MAX_MS)
+   {
+      u16Ms=KERNEL_MAX_MS;
+   }
+   return (uint16_t)KERNEL_MS_TO_TICKS(u16Ms);
+}
+
+static void Kernel_Copy(uint8_t* pu8To, const uint8_t* pu8From, uint8_t u8Size)
+{
+   while (u8Size--)
+   {
+      *pu8To++=*pu8From++;
+   }
+}
+
+//pick the highest ready task, the first one after the running task among equals, so tasks
+//of the same priority take turns, called with interrupts masked, not static as only the assembly calls it
+void Kernel_Switch(void);
+void Kernel_Switch(void)
+{
+   uint8_t u8Index=Gu8_KernelCurrent;
+   uint8_t u8Best=KERNEL_IDLE;
+   uint8_t u8BestPriority=0;
+   uint8_t u8Count;
+
+   if (Gu8_KernelStarted == 0)
+   {
+      return;
+   }
+   for (u8Count=0;u8Count<Gu8_KernelTaskCount;u8Count++)
+   {
+      u8Index=(u8Index >= Gu8_KernelTaskCount-1) ? 0 : u8Index+1;
+      if (Gastr_KernelTasks[u8Index].u8State == KERNEL_READY && Gastr_KernelTasks[u8Index].u8Priority > u8BestPriority)
+      {
+         u8Best=u8Index;
+         u8BestPriority=Gastr_KernelTasks[u8Index].u8Priority;
+      }
+   }
+   if (u8Best != Gu8_KernelCurrent)
+   {
+      Gu8_KernelCurrent=u8Best;
+      Gpstr_KernelCurrent=&Gastr_KernelTasks[u8Best];
+      Gu32_KernelSwitches++;
+   }
+}
+
+//called from the naked tick with interrupts masked: ends the timeouts and switches, not static
+//as only the assembly calls it
+void Kernel_TickHandler(void);
+void Kernel_TickHandler(void)
+{
+   strKernelTask_t* pstrTask;
+   uint8_t u8Index;
+
+   Gu32_KernelTicks++;
+   for (u8Index=0;u8Index<Gu8_KernelTaskCount;u8Index++)
+   {
+      pstrTask=&Gastr_KernelTasks[u8Index];
+      if (pstrTask->u8State == KERNEL_BLOCKED && pstrTask->u16Timeout != KERNEL_FOREVER_TICKS)
+      {
+         if (--pstrTask->u16Timeout == 0)
+         {
+            if (pstrTask->pu8WaitList != NULLPTR)
+            {
+               *pstrTask->pu8WaitList&=(uint8_t)~(1<<u8Index);
+               pstrTask->pu8WaitList=NULLPTR;
+            }
+            pstrTask->u8Woken=0;
+            pstrTask->u8State=KERNEL_READY;
+         }
+      }
+   }
+   Kernel_Switch();
+}
+
+//context switch of the tick, the interrupted task's stack ends with the ISR's return address
+//under this call's, so any later restore returns through the reti of the ISR
+static void Kernel_TickYield(void) __attribute__((naked,used));
+static void Kernel_TickYield(void)
+{
+   __asm__ __volatile__
+   (
+      KERNEL_SAVE_CONTEXT
+      "call Kernel_TickHandler      \n\t"
+      KERNEL_RESTORE_CONTEXT
+      "ret                          \n\t"
+      :: [sreg] "I" (SREG_IO), [spl] "I" (SPL_IO), [sph] "I" (SPH_IO)
+   );
+}
+
+//block the running task in the waiter bits pu8Waiters (NULLPTR for a plain delay) for
+//u16Ticks, called with interrupts masked (they stay masked), returns u8Woken
+static uint8_t Kernel_Block(volatile uint8_t* pu8Waiters, uint16_t u16Ticks)
+{
+   strKernelTask_t* pstrTask=Gpstr_KernelCurrent;
+
+   pstrTask->u16Timeout=u16Ticks;
+   pstrTask->pu8WaitList=pu8Waiters;
+   pstrTask->u8Woken=0;
+   pstrTask->u8State=KERNEL_BLOCKED;
+   if (pu8Waiters != NULLPTR)
+   {
+      *pu8Waiters|=(uint8_t)(1<<Gu8_KernelCurrent);
+   }
+   Kernel_Yield();
+   return pstrTask->u8Woken;
+}
+
+//make the highest waiting task in pu8Waiters ready, called with interrupts masked,
+//returns its priority or 0 if nobody waits
+static uint8_t Kernel_Wake(volatile uint8_t* pu8Waiters)
+{
+   strKernelTask_t* pstrTask;
+   uint8_t u8Index;
+   uint8_t u8Best=KERNEL_IDLE;
+   uint8_t u8BestPriority=0;
+
+   if (*pu8Waiters == 0)
+   {
+      return 0;
+   }
+   for (u8Index=0;u8Index<Gu8_KernelTaskCount;u8Index++)
+   {
+      if ((*pu8Waiters & (1<<u8Index)) && Gastr_KernelTasks[u8Index].u8Priority > u8BestPriority)
+      {
+         u8Best=u8Index;
+         u8BestPriority=Gastr_KernelTasks[u8Index].u8Priority;
+      }
+   }
+   *pu8Waiters&=(uint8_t)~(1<<u8Best);
+   pstrTask=&Gastr_KernelTasks[u8Best];
+   pstrTask->pu8WaitList=NULLPTR;
+   pstrTask->u8Woken=1;
+   pstrTask->u8State=KERNEL_READY;
+   return u8BestPriority;
+}
+
+//switch to a task a give or send woke if it outranks the caller, interrupts masked
+static void Kernel_Preempt(uint8_t u8WokenPriority)
+{
+   if (u8WokenPriority > Gpstr_KernelCurrent->u8Priority)
+   {
+      Kernel_Yield();
+   }
+}
+
+//a task function returned here
+static void Kernel_TaskExit(void)
+{
+   cli();
+   Gpstr_KernelCurrent->u8State=KERNEL_DEAD;
+   while (1)
+   {
+      Kernel_Yield();
+   }
+}
+
+
+/************************************************************************************
+* Parameters (in): pfKernelTask_t pfEntry, void* pvArg, uint8_t* pu8Stack, uint16_t u16StackSize,
+*                  uint8_t u8Priority, uint8_t* pu8TaskId
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to create a task running pfEntry(pvArg) on the stack pu8Stack of
+*              u16StackSize bytes (KERNEL_STACK) at u8Priority (1 lowest), a task that returns
+*              from pfEntry ends, must be called before Kernel_Start
+************************************************************************************/
+enuErrorStatus_t Kernel_TaskCreate(pfKernelTask_t pfEntry, void* pvArg, uint8_t* pu8Stack, uint16_t u16StackSize,
+                                   uint8_t u8Priority, uint8_t* pu8TaskId)
+{
+   strKernelTask_t* pstrTask;
+   uint8_t* pu8Top;
+   uint16_t u16Address;
+   uint16_t u16Index;
+   uint8_t  u8Reg;
+
+   if (pfEntry == NULLPTR || pu8Stack == NULLPTR || pu8TaskId == NULLPTR || u8Priority == 0 ||
+       u16StackSize < KERNEL_STACK_OVERHEAD || Gu8_KernelStarted || Gu8_KernelTaskCount >= KERNEL_TASKS_MAX)
+   {
+      return ERROR;
+   }
+   //paint the stack for Kernel_StackFree
+   for (u16Index=0;u16Index<u16StackSize;u16Index++)
+   {
+      pu8Stack[u16Index]=KERNEL_STACK_PAINT;
+   }
+   //build the frame KERNEL_RESTORE_CONTEXT pops, pushes go down from the last byte
+   pu8Top=&pu8Stack[u16StackSize-1];
+   //pfEntry returns into Kernel_TaskExit, the restore returns into pfEntry (low byte pushed first)
+   u16Address=(uint16_t)(__UINTPTR_TYPE__)Kernel_TaskExit;
+   *pu8Top--=(uint8_t)u16Address;
+   *pu8Top--=(uint8_t)(u16Address>>8);
+   u16Address=(uint16_t)(__UINTPTR_TYPE__)pfEntry;
+   *pu8Top--=(uint8_t)u16Address;
+   *pu8Top--=(uint8_t)(u16Address>>8);
+   *pu8Top--=0;                     //r0
+   *pu8Top--=0x80;                  //SREG, interrupts on
+   for (u8Reg=1;u8Reg<=31;u8Reg++)
+   {
+      //the argument goes in r24:r25
+      if (u8Reg == 24)
+      {
+         *pu8Top--=(uint8_t)(__UINTPTR_TYPE__)pvArg;
+      }
+      else if (u8Reg == 25)
+      {
+         *pu8Top--=(uint8_t)((__UINTPTR_TYPE__)pvArg>>8);
+      }
+      else
+      {
+         *pu8Top--=0;
+      }
+   }
+
+   pstrTask=&Gastr_KernelTasks[Gu8_KernelTaskCount];
+   pstrTask->u16Sp=(uint16_t)(__UINTPTR_TYPE__)pu8Top;
+   pstrTask->pu8Stack=pu8Stack;
+   pstrTask->u16StackSize=u16StackSize;
+   pstrTask->u16Timeout=0;
+   pstrTask->pu8WaitList=NULLPTR;
+   pstrTask->u8Priority=u8Priority;
+   pstrTask->u8Woken=0;
+   pstrTask->u8State=KERNEL_READY;
+   *pu8TaskId=Gu8_KernelTaskCount;
+   Gu8_KernelTaskCount++;
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): void(*pfIdle)(void)
+* Parameters (out): enuErrorStatus_t
+* Return value: 0=FAIL (no timer setting for KERNEL_TICK_US), never returns otherwise
+* Description: A function to start the tick and run the tasks, main() goes on as the idle task
+*              calling pfIdle (may be NULLPTR) over and over
+************************************************************************************/
+enuErrorStatus_t Kernel_Start(void(*pfIdle)(void))
+{
+   strTimerSolution_t strSolution;
+
+   if (Gu8_KernelStarted ||
+       TimerSolve(TIMERSOLVE_TIMER2,TIMERSOLVE_CTC,CLOCK_US_TO_CYCLES(KERNEL_TICK_US),1,1,&strSolution) == ERROR)
+   {
+      return ERROR;
+   }
+   cli();
+   //main's context is saved in the idle slot on the first switch
+   Gastr_KernelTasks[KERNEL_IDLE].u8Priority=0;
+   Gastr_KernelTasks[KERNEL_IDLE].u8State=KERNEL_READY;
+   Gu8_KernelCurrent=KERNEL_IDLE;
+   Gpstr_KernelCurrent=&Gastr_KernelTasks[KERNEL_IDLE];
+   Gu8_KernelStarted=1;
+   //timer 2 CTC at the tick period
+   TCCR2_R=0;
+   TCNT2_R=0;
+   OCR2_R=(uint8_t)strSolution.u16Top;
+   TIFR_R=(1<<OCF2_B);
+   TIMSK_R|=(1<<OCIE2_B);
+   TCCR2_R=(1<<WGM21_B) | strSolution.u8Scaler;
+   sei();
+   Kernel_Yield();
+   while (1)
+   {
+      if (pfIdle != NULLPTR)
+      {
+         pfIdle();
+      }
+   }
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): void
+* Return value: void
+* Description: A function to give the CPU to the highest ready task (the next one of the same
+*              priority if the caller is still ready)
+************************************************************************************/
+void Kernel_Yield(void) __attribute__((naked));
+void Kernel_Yield(void)
+{
+   __asm__ __volatile__
+   (
+      KERNEL_SAVE_CONTEXT
+      "call Kernel_Switch           \n\t"
+      KERNEL_RESTORE_CONTEXT
+      "ret                          \n\t"
+      :: [sreg] "I" (SREG_IO), [spl] "I" (SPL_IO), [sph] "I" (SPH_IO)
+   );
+}
+
+/************************************************************************************
+* Parameters (in): uint16_t u16Ms
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (called from the idle task)
+* Description: A function to block the calling task for u16Ms milliseconds (up to KERNEL_MAX_MS)
+************************************************************************************/
+enuErrorStatus_t Kernel_Delay(uint16_t u16Ms)
+{
+   uint8_t u8Sreg;
+   if (Gu8_KernelCurrent == KERNEL_IDLE || u16Ms > KERNEL_MAX_MS)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   if (u16Ms == 0)
+   {
+      Kernel_Yield();
+   }
+   else
+   {
+      (void)Kernel_Block(NULLPTR,Kernel_Ticks(u16Ms));
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): strKernelSem_t* pstrSem, uint8_t u8Count
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set up a semaphore with u8Count free units
+************************************************************************************/
+enuErrorStatus_t Kernel_SemInit(strKernelSem_t* pstrSem, uint8_t u8Count)
+{
+   if (pstrSem == NULLPTR)
+   {
+      return ERROR;
+   }
+   pstrSem->u8Count=u8Count;
+   pstrSem->u8Waiters=0;
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): strKernelSem_t* pstrSem, uint16_t u16TimeoutMs
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (timeout)
+* Description: A function to take a unit of the semaphore, waiting up to u16TimeoutMs for one
+************************************************************************************/
+enuErrorStatus_t Kernel_SemTake(strKernelSem_t* pstrSem, uint16_t u16TimeoutMs)
+{
+   enuErrorStatus_t enuStatus=ERROR;
+   uint8_t u8Sreg;
+
+   if (pstrSem == NULLPTR)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   if (pstrSem->u8Count > 0)
+   {
+      pstrSem->u8Count--;
+      enuStatus=SUCCESS;
+   }
+   else if (u16TimeoutMs != 0 && Gu8_KernelCurrent != KERNEL_IDLE)
+   {
+      //a give hands its unit straight to the woken task
+      if (Kernel_Block(&pstrSem->u8Waiters,Kernel_Ticks(u16TimeoutMs)))
+      {
+         enuStatus=SUCCESS;
+      }
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return enuStatus;
+}
+
+/************************************************************************************
+* Parameters (in): strKernelSem_t* pstrSem
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (count at 255)
+* Description: A function to give a unit to the semaphore from a task, a waiting task of higher
+*              priority runs at once
+************************************************************************************/
+enuErrorStatus_t Kernel_SemGive(strKernelSem_t* pstrSem)
+{
+   enuErrorStatus_t enuStatus;
+   uint8_t u8Sreg;
+   uint8_t u8Priority;
+
+   if (pstrSem == NULLPTR)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   u8Priority=Kernel_Wake(&pstrSem->u8Waiters);
+   if (u8Priority != 0)
+   {
+      Kernel_Preempt(u8Priority);
+      enuStatus=SUCCESS;
+   }
+   else if (pstrSem->u8Count == 0xFF)
+   {
+      enuStatus=ERROR;
+   }
+   else
+   {
+      pstrSem->u8Count++;
+      enuStatus=SUCCESS;
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return enuStatus;
+}
+
+/************************************************************************************
+* Parameters (in): strKernelSem_t* pstrSem
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (count at 255)
+* Description: A function to give a unit to the semaphore from an ISR
+************************************************************************************/
+enuErrorStatus_t Kernel_SemGiveISR(strKernelSem_t* pstrSem)
+{
+   enuErrorStatus_t enuStatus=SUCCESS;
+   uint8_t u8Sreg;
+
+   if (pstrSem == NULLPTR)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   if (Kernel_Wake(&pstrSem->u8Waiters) == 0)
+   {
+      if (pstrSem->u8Count == 0xFF)
+      {
+         enuStatus=ERROR;
+      }
+      else
+      {
+         pstrSem->u8Count++;
+      }
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return enuStatus;
+}
+
+/************************************************************************************
+* Parameters (in): strKernelQueue_t* pstrQueue, uint8_t* pu8Buffer, uint8_t u8ItemSize, uint8_t u8Length
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set up a queue of u8Length items of u8ItemSize bytes in pu8Buffer
+*              (u8ItemSize*u8Length bytes)
+************************************************************************************/
+enuErrorStatus_t Kernel_QueueInit(strKernelQueue_t* pstrQueue, uint8_t* pu8Buffer, uint8_t u8ItemSize, uint8_t u8Length)
+{
+   if (pstrQueue == NULLPTR || pu8Buffer == NULLPTR || u8ItemSize == 0 || u8Length == 0)
+   {
+      return ERROR;
+   }
+   pstrQueue->pu8Buffer=pu8Buffer;
+   pstrQueue->u8ItemSize=u8ItemSize;
+   pstrQueue->u8Length=u8Length;
+   pstrQueue->u8Head=0;
+   pstrQueue->u8Count=0;
+   pstrQueue->u8RxWaiters=0;
+   pstrQueue->u8TxWaiters=0;
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): strKernelQueue_t* pstrQueue, const void* pvItem, uint16_t u16TimeoutMs
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (timeout)
+* Description: A function to copy an item into the queue, waiting up to u16TimeoutMs for room
+************************************************************************************/
+enuErrorStatus_t Kernel_QueueSend(strKernelQueue_t* pstrQueue, const void* pvItem, uint16_t u16TimeoutMs)
+{
+   enuErrorStatus_t enuStatus=ERROR;
+   uint16_t u16Ticks;
+   uint8_t  u8Sreg;
+
+   if (pstrQueue == NULLPTR || pvItem == NULLPTR)
+   {
+      return ERROR;
+   }
+   u16Ticks=(u16TimeoutMs == 0 || Gu8_KernelCurrent == KERNEL_IDLE) ? 0 : Kernel_Ticks(u16TimeoutMs);
+   ATOMIC_ENTER(u8Sreg);
+   while (1)
+   {
+      if (pstrQueue->u8Count < pstrQueue->u8Length)
+      {
+         //Kernel_QueueSendISR can not fail with room and only wakes, the switch is done here
+         (void)Kernel_QueueSendISR(pstrQueue,pvItem);
+         enuStatus=SUCCESS;
+         break;
+      }
+      //a woken sender can still find the queue full if a higher task filled it first,
+      //it waits again for the ticks left
+      if (u16Ticks == 0 || Kernel_Block(&pstrQueue->u8TxWaiters,u16Ticks) == 0)
+      {
+         break;
+      }
+      u16Ticks=Gpstr_KernelCurrent->u16Timeout;
+   }
+   if (enuStatus == SUCCESS)
+   {
+      Kernel_Preempt(Kernel_Wake(&pstrQueue->u8RxWaiters));
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return enuStatus;
+}
+
+/************************************************************************************
+* Parameters (in): strKernelQueue_t* pstrQueue, const void* pvItem
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (queue full)
+* Description: A function to copy an item into the queue from an ISR
+************************************************************************************/
+enuErrorStatus_t Kernel_QueueSendISR(strKernelQueue_t* pstrQueue, const void* pvItem)
+{
+   enuErrorStatus_t enuStatus=ERROR;
+   uint8_t u8Sreg;
+   uint8_t u8Tail;
+
+   if (pstrQueue == NULLPTR || pvItem == NULLPTR)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   if (pstrQueue->u8Count < pstrQueue->u8Length)
+   {
+      u8Tail=pstrQueue->u8Head+pstrQueue->u8Count;
+      if (u8Tail >= pstrQueue->u8Length)
+      {
+         u8Tail-=pstrQueue->u8Length;
+      }
+      Kernel_Copy(&pstrQueue->pu8Buffer[(uint16_t)u8Tail*pstrQueue->u8ItemSize],(const uint8_t*)pvItem,pstrQueue->u8ItemSize);
+      pstrQueue->u8Count++;
+      enuStatus=SUCCESS;
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return enuStatus;
+}
+
+/************************************************************************************
+* Parameters (in): strKernelQueue_t* pstrQueue, void* pvItem, uint16_t u16TimeoutMs
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (timeout)
+* Description: A function to copy the oldest item out of the queue, waiting up to u16TimeoutMs for one
+************************************************************************************/
+enuErrorStatus_t Kernel_QueueReceive(strKernelQueue_t* pstrQueue, void* pvItem, uint16_t u16TimeoutMs)
+{
+   enuErrorStatus_t enuStatus=ERROR;
+   uint16_t u16Ticks;
+   uint8_t  u8Sreg;
+
+   if (pstrQueue == NULLPTR || pvItem == NULLPTR)
+   {
+      return ERROR;
+   }
+   u16Ticks=(u16TimeoutMs == 0 || Gu8_KernelCurrent == KERNEL_IDLE) ? 0 : Kernel_Ticks(u16TimeoutMs);
+   ATOMIC_ENTER(u8Sreg);
+   while (1)
+   {
+      if (pstrQueue->u8Count > 0)
+      {
+         Kernel_Copy((uint8_t*)pvItem,&pstrQueue->pu8Buffer[(uint16_t)pstrQueue->u8Head*pstrQueue->u8ItemSize],pstrQueue->u8ItemSize);
+         pstrQueue->u8Head=(pstrQueue->u8Head+1 >= pstrQueue->u8Length) ? 0 : pstrQueue->u8Head+1;
+         pstrQueue->u8Count--;
+         enuStatus=SUCCESS;
+         break;
+      }
+      if (u16Ticks == 0 || Kernel_Block(&pstrQueue->u8RxWaiters,u16Ticks) == 0)
+      {
+         break;
+      }
+      u16Ticks=Gpstr_KernelCurrent->u16Timeout;
+   }
+   if (enuStatus == SUCCESS)
+   {
+      Kernel_Preempt(Kernel_Wake(&pstrQueue->u8TxWaiters));
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return enuStatus;
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t u8TaskId, uint16_t* pu16Free
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the stack bytes a task never used (0 means it overflowed)
+************************************************************************************/
+enuErrorStatus_t Kernel_StackFree(uint8_t u8TaskId, uint16_t* pu16Free)
+{
+   strKernelTask_t* pstrTask;
+   uint16_t u16Free=0;
+
+   if (u8TaskId >= Gu8_KernelTaskCount || pu16Free == NULLPTR)
+   {
+      return ERROR;
+   }
+   pstrTask=&Gastr_KernelTasks[u8TaskId];
+   //the stack grows down to pu8Stack[0], count the paint left from there
+   while (u16Free < pstrTask->u16StackSize && pstrTask->pu8Stack[u16Free] == KERNEL_STACK_PAINT)
+   {
+      u16Free++;
+   }
+   *pu16Free=u16Free;
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): strKernelStats_t* pstrStats
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the tick and context switch counts
+************************************************************************************/
+enuErrorStatus_t Kernel_GetStats(strKernelStats_t* pstrStats)
+{
+   uint8_t u8Sreg;
+   if (pstrStats == NULLPTR)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   pstrStats->u32Ticks=Gu32_KernelTicks;
+   pstrStats->u32Switches=Gu32_KernelSwitches;
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+
+/******************** Interrupt Handlers ****************************************/
+
+//the tick, naked so the whole context of the interrupted task is saved by Kernel_TickYield
+ISR(TIMER2_COMP_vect,ISR_NAKED)
+{
+   __asm__ __volatile__
+   (
+      "call Kernel_TickYield        \n\t"
+      "reti                         \n\t"
+      ::
+   );
+}
+
+#endif /* KERNEL_ENABLE */
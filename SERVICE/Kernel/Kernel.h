@@ -0,0 +1,213 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: Kernel.h
+* Description: File containing function prototypes for Kernel.c
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __KERNEL__
+#define __KERNEL__
+
+#include "DataTypes.h"
+#include "Utils.h"
+#include "Register.h"
+#include "Atomic.h"
+#include "Clock.h"
+#include "TimerSolve.h"
+
+/*
+ * Preemptive priority kernel, built with KERNEL_ENABLE defined.
+ * Every task has its own stack (KERNEL_STACK, sized at compile time) and a priority from 1 to
+ * 255, the highest ready task runs and tasks of the same priority share the CPU a tick at a
+ * time. The tick is a timer 2 compare match every KERNEL_TICK_US with a naked ISR that saves
+ * the whole context (r0-r31 and SREG) on the stack of the running task, the rest of the
+ * interrupts are unchanged and run on the stack of whatever task they interrupt.
+ * main() becomes the idle task in Kernel_Start and runs when no task is ready.
+ *
+ * Blocking calls take a timeout in milliseconds (rounded up to ticks, KERNEL_WAIT_FOREVER to
+ * wait without one, 0 to poll) and fail when it runs out:
+ *    Kernel_Delay                    sleep
+ *    Kernel_SemTake/Kernel_SemGive   counting semaphore
+ *    Kernel_QueueSend/Receive        fixed size items copied through a caller buffer
+ * A task woken by Give or Send runs at once if it has a higher priority than the caller. The
+ * ISR versions never switch, the woken task runs on the next tick, or at once if the ISR
+ * calls Kernel_Yield as its last statement.
+ *
+ * Cost (instruction count of the naked code, not measured, no simulator in this tree):
+ *    context save 79 cycles, restore 77 cycles, ISR entry, call, ret and reti 16, so ~172
+ *    cycles per switch
+ *    the tick adds ~20 cycles per task for the timeouts and the ready scan, with 4 tasks
+ *    ~330 cycles a tick: 41 us at 8 MHz, 4% of the CPU at a 1 ms tick
+ * A stack needs 37 bytes for a preempted context (32 registers, SREG and two 2 byte return
+ * addresses) plus the deepest interrupt it can see on top of the task's own use, KERNEL_STACK
+ * adds KERNEL_STACK_OVERHEAD for that.
+ *
+ * Timer 2 belongs to the kernel and its compare vector is taken out of Vect.c (Vect_Cfg.h).
+ * With KERNEL_ENABLE defined Counter_FreqMeterStart and the Osc functions that use timer 2
+ * return ERROR instead of reprogramming it.
+ */
+
+//configuration
+#define KERNEL_TASKS_MAX         6           //tasks besides the idle task, up to 8
+#define KERNEL_TICK_US           1000UL
+#define KERNEL_STACK_OVERHEAD    80          //saved context and the interrupts on top of a task
+
+#if KERNEL_TASKS_MAX > 8
+#error "Kernel: the waiting tasks are kept in one byte, KERNEL_TASKS_MAX can not exceed 8"
+#endif
+
+#define KERNEL_WAIT_FOREVER      0xFFFF
+#define KERNEL_MS_TO_TICKS(ms)   (((uint32_t)(ms)*1000UL+KERNEL_TICK_US-1)/KERNEL_TICK_US)
+//longest timeout in milliseconds, a longer one would look like KERNEL_WAIT_FOREVER in ticks
+#define KERNEL_MAX_MS            ((0xFFFEUL*KERNEL_TICK_US)/1000UL)
+
+//a stack of u16Bytes for the task's own use
+#define KERNEL_STACK(name,u16Bytes)    uint8_t name[(u16Bytes)+KERNEL_STACK_OVERHEAD]
+
+typedef void (*pfKernelTask_t)(void* pvArg);
+
+typedef struct
+{
+   volatile uint8_t u8Count;
+   volatile uint8_t u8Waiters;      //bit per waiting task
+}strKernelSem_t;
+
+typedef struct
+{
+   uint8_t* pu8Buffer;
+   uint8_t  u8ItemSize;
+   uint8_t  u8Length;               //items the buffer holds
+   volatile uint8_t u8Head;
+   volatile uint8_t u8Count;
+   volatile uint8_t u8RxWaiters;    //tasks waiting for an item
+   volatile uint8_t u8TxWaiters;    //tasks waiting for room
+}strKernelQueue_t;
+
+typedef struct
+{
+   uint32_t u32Ticks;
+   uint32_t u32Switches;            //ticks and calls that changed the running task
+}strKernelStats_t;
+
+/************************************************************************************
+* Parameters (in): pfKernelTask_t pfEntry, void* pvArg, uint8_t* pu8Stack, uint16_t u16StackSize,
+*                  uint8_t u8Priority, uint8_t* pu8TaskId
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to create a task running pfEntry(pvArg) on the stack pu8Stack of
+*              u16StackSize bytes (KERNEL_STACK) at u8Priority (1 lowest), a task that returns
+*              from pfEntry ends, must be called before Kernel_Start
+************************************************************************************/
+enuErrorStatus_t Kernel_TaskCreate(pfKernelTask_t pfEntry, void* pvArg, uint8_t* pu8Stack, uint16_t u16StackSize,
+                                   uint8_t u8Priority, uint8_t* pu8TaskId);
+
+/************************************************************************************
+* Parameters (in): void(*pfIdle)(void)
+* Parameters (out): enuErrorStatus_t
+* Return value: 0=FAIL (no timer setting for KERNEL_TICK_US), never returns otherwise
+* Description: A function to start the tick and run the tasks, main() goes on as the idle task
+*              calling pfIdle (may be NULLPTR) over and over
+************************************************************************************/
+enuErrorStatus_t Kernel_Start(void(*pfIdle)(void));
+
+/************************************************************************************
+* Parameters (in): void
+* Parameters (out): void
+* Return value: void
+* Description: A function to give the CPU to the highest ready task (the next one of the same
+*              priority if the caller is still ready)
+************************************************************************************/
+void Kernel_Yield(void);
+
+/************************************************************************************
+* Parameters (in): uint16_t u16Ms
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (called from the idle task)
+* Description: A function to block the calling task for u16Ms milliseconds (up to KERNEL_MAX_MS)
+************************************************************************************/
+enuErrorStatus_t Kernel_Delay(uint16_t u16Ms);
+
+/************************************************************************************
+* Parameters (in): strKernelSem_t* pstrSem, uint8_t u8Count
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set up a semaphore with u8Count free units
+************************************************************************************/
+enuErrorStatus_t Kernel_SemInit(strKernelSem_t* pstrSem, uint8_t u8Count);
+
+/************************************************************************************
+* Parameters (in): strKernelSem_t* pstrSem, uint16_t u16TimeoutMs
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (timeout)
+* Description: A function to take a unit of the semaphore, waiting up to u16TimeoutMs for one
+************************************************************************************/
+enuErrorStatus_t Kernel_SemTake(strKernelSem_t* pstrSem, uint16_t u16TimeoutMs);
+
+/************************************************************************************
+* Parameters (in): strKernelSem_t* pstrSem
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (count at 255)
+* Description: A function to give a unit to the semaphore from a task, a waiting task of higher
+*              priority runs at once
+************************************************************************************/
+enuErrorStatus_t Kernel_SemGive(strKernelSem_t* pstrSem);
+
+/************************************************************************************
+* Parameters (in): strKernelSem_t* pstrSem
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (count at 255)
+* Description: A function to give a unit to the semaphore from an ISR
+************************************************************************************/
+enuErrorStatus_t Kernel_SemGiveISR(strKernelSem_t* pstrSem);
+
+/************************************************************************************
+* Parameters (in): strKernelQueue_t* pstrQueue, uint8_t* pu8Buffer, uint8_t u8ItemSize, uint8_t u8Length
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to set up a queue of u8Length items of u8ItemSize bytes in pu8Buffer
+*              (u8ItemSize*u8Length bytes)
+************************************************************************************/
+enuErrorStatus_t Kernel_QueueInit(strKernelQueue_t* pstrQueue, uint8_t* pu8Buffer, uint8_t u8ItemSize, uint8_t u8Length);
+
+/************************************************************************************
+* Parameters (in): strKernelQueue_t* pstrQueue, const void* pvItem, uint16_t u16TimeoutMs
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (timeout)
+* Description: A function to copy an item into the queue, waiting up to u16TimeoutMs for room
+************************************************************************************/
+enuErrorStatus_t Kernel_QueueSend(strKernelQueue_t* pstrQueue, const void* pvItem, uint16_t u16TimeoutMs);
+
+/************************************************************************************
+* Parameters (in): strKernelQueue_t* pstrQueue, const void* pvItem
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (queue full)
+* Description: A function to copy an item into the queue from an ISR
+************************************************************************************/
+enuErrorStatus_t Kernel_QueueSendISR(strKernelQueue_t* pstrQueue, const void* pvItem);
+
+/************************************************************************************
+* Parameters (in): strKernelQueue_t* pstrQueue, void* pvItem, uint16_t u16TimeoutMs
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL (timeout)
+* Description: A function to copy the oldest item out of the queue, waiting up to u16TimeoutMs for one
+************************************************************************************/
+enuErrorStatus_t Kernel_QueueReceive(strKernelQueue_t* pstrQueue, void* pvItem, uint16_t u16TimeoutMs);
+
+/************************************************************************************
+* Parameters (in): uint8_t u8TaskId, uint16_t* pu16Free
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the stack bytes a task never used (0 means it overflowed)
+************************************************************************************/
+enuErrorStatus_t Kernel_StackFree(uint8_t u8TaskId, uint16_t* pu16Free);
+
+/************************************************************************************
+* Parameters (in): strKernelStats_t* pstrStats
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to read the tick and context switch counts
+************************************************************************************/
+enuErrorStatus_t Kernel_GetStats(strKernelStats_t* pstrStats);
+
+#endif /* __KERNEL__ */
@@ -0,0 +1,117 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: PT.c
+* Description: File containing the protothread wait functions
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#include "PT.h"
+
+#if PT_EVENTS_NO > 16
+#error "PT: the events are kept in 16 bits, PT_EVENTS_NO can not exceed 16"
+#endif
+
+//bit per signaled event that no thread took yet
+volatile uint16_t Gu16_PTEvents=0;
+
+
+/************************************************************************************
+* Parameters (in): strPT_t* pstrPT
+* Parameters (out): uint8_t
+* Return value: 1 if the deadline of the thread has passed, else 0
+* Description: A function to check the time wait of a thread, used by the PT_AWAIT_*MS macros
+************************************************************************************/
+uint8_t PT_Expired(strPT_t* pstrPT)
+{
+   //signed difference, the time base wraps around
+   return (sint32_t)(STimer_Now()-pstrPT->u32Deadline) >= 0;
+}
+
+/************************************************************************************
+* Parameters (in): strPT_t* pstrPT, uint8_t u8Cond
+* Parameters (out): uint8_t
+* Return value: 1 if u8Cond is true or the deadline of the thread has passed, else 0
+* Description: A function to check the wait of PT_AWAIT_UNTIL_MS and record which one ended it,
+*              the condition wins over a deadline that passed at the same check
+************************************************************************************/
+uint8_t PT_CondOrExpired(strPT_t* pstrPT, uint8_t u8Cond)
+{
+   pstrPT->u8TimedOut=!u8Cond && PT_Expired(pstrPT);
+   return u8Cond || pstrPT->u8TimedOut;
+}
+
+/************************************************************************************
+* Parameters (in): strPT_t* pstrPT
+* Parameters (out): uint8_t
+* Return value: 1 if the last PT_AWAIT_UNTIL_MS ended on its timeout, else 0
+* Description: A function to tell after PT_AWAIT_UNTIL_MS if the condition or the time ended the wait
+************************************************************************************/
+uint8_t PT_TimedOut(strPT_t* pstrPT)
+{
+   //recorded when the wait ended, later code running past the deadline does not change it
+   return pstrPT->u8TimedOut;
+}
+
+/************************************************************************************
+* Parameters (in): enuDIOPinNo_t enuPin, uint8_t u8Level
+* Parameters (out): uint8_t
+* Return value: 1 if the pin reads u8Level, else 0 (also for an invalid pin)
+* Description: A function to compare a pin with a level, used by PT_AWAIT_PIN
+************************************************************************************/
+uint8_t PT_PinIs(enuDIOPinNo_t enuPin, uint8_t u8Level)
+{
+   uint8_t u8Data;
+   if (DIO_Read(enuPin,&u8Data) == ERROR)
+   {
+      return 0;
+   }
+   return (u8Data != 0) == (u8Level != 0);
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Event
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to signal event u8Event (0 to PT_EVENTS_NO-1), callable from an ISR,
+*              a signal nobody took yet is not counted twice
+************************************************************************************/
+enuErrorStatus_t PT_EventSignal(uint8_t u8Event)
+{
+   uint8_t u8Sreg;
+   if (u8Event >= PT_EVENTS_NO)
+   {
+      return ERROR;
+   }
+   ATOMIC_ENTER(u8Sreg);
+   Gu16_PTEvents|=(uint16_t)1<<u8Event;
+   ATOMIC_EXIT(u8Sreg);
+   return SUCCESS;
+}
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Event
+* Parameters (out): uint8_t
+* Return value: 1 if the event was signaled (it is taken), else 0
+* Description: A function to take a signaled event, used by PT_AWAIT_EVENT
+************************************************************************************/
+uint8_t PT_EventTake(uint8_t u8Event)
+{
+   uint8_t  u8Sreg;
+   uint8_t  u8Taken=0;
+   uint16_t u16Mask;
+   if (u8Event >= PT_EVENTS_NO)
+   {
+      return 0;
+   }
+   u16Mask=(uint16_t)1<<u8Event;
+   //test and clear in one section, an ISR may signal between them
+   ATOMIC_ENTER(u8Sreg);
+   if (Gu16_PTEvents & u16Mask)
+   {
+      Gu16_PTEvents&=(uint16_t)~u16Mask;
+      u8Taken=1;
+   }
+   ATOMIC_EXIT(u8Sreg);
+   return u8Taken;
+}
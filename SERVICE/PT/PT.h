@@ -0,0 +1,156 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: PT.h
+* Description: File containing the protothread macros and function prototypes for PT.c
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __PT__
+#define __PT__
+
+#include "DataTypes.h"
+#include "Utils.h"
+#include "Register.h"
+#include "Atomic.h"
+#include "DIO.h"
+#include "STimer.h"
+
+/*
+ * Protothreads: sequential code that waits without a stack of its own.
+ * A thread is a function taking its strPT_t and returning enuPTState_t, its body sits between
+ * PT_BEGIN and PT_END. A wait stores the source line in the strPT_t and returns, the next call
+ * jumps back to that line through the switch in PT_BEGIN (Duff's device), so a thread costs
+ * the 7 bytes of its strPT_t and no stack while it waits. The main loop calls every thread
+ * over and over:
+ *
+ *    enuPTState_t Blink(strPT_t* pstrPT)
+ *    {
+ *       PT_BEGIN(pstrPT);
+ *       while (1)
+ *       {
+ *          DIO_Write(LED1,1);
+ *          PT_AWAIT_MS(pstrPT,200);
+ *          PT_AWAIT_PIN(pstrPT,Button1,0);
+ *          DIO_Write(LED1,0);
+ *          PT_AWAIT_MS(pstrPT,50);
+ *       }
+ *       PT_END(pstrPT);
+ *    }
+ *    ...
+ *    PT_INIT(&Gstr_BlinkPT);
+ *    while (1) { Blink(&Gstr_BlinkPT); Other(&Gstr_OtherPT); }
+ *
+ * The waits on time all use the software timer time base (STimer_Init has to be called), one
+ * comparison with the deadline in the strPT_t per call and no timer per thread. Events are
+ * PT_EVENTS_NO flags set with PT_EventSignal (also from an ISR) and taken by the first thread
+ * that waits on them.
+ *
+ * Rules of the switch: local variables lose their value across a wait (keep them static or
+ * in a struct next to the strPT_t), and a wait can not be inside a switch of the thread.
+ */
+
+#define PT_EVENTS_NO             16
+//longest time one wait can take
+#define PT_MAX_MS                (STIMER_MAX_US/1000UL)
+#define PT_MS_TO_TICKS(ms)       STIMER_US_TO_TICKS((uint32_t)(ms)*1000UL)
+
+typedef enum
+{
+   PT_WAITING=0,
+   PT_YIELDED,
+   PT_EXITED,
+   PT_ENDED
+
+}enuPTState_t;
+
+typedef struct
+{
+   uint16_t u16Lc;            //line the thread continues at, 0 to start over
+   uint32_t u32Deadline;      //time base tick of the current time wait
+   uint8_t  u8TimedOut;       //1 if the last PT_AWAIT_UNTIL_MS ended on its timeout
+}strPT_t;
+
+#define PT_INIT(pstrPT)                do{ (pstrPT)->u16Lc=0; (pstrPT)->u8TimedOut=0; }while(0)
+#define PT_BEGIN(pstrPT)               { uint8_t u8PTYield=1; (void)u8PTYield; switch ((pstrPT)->u16Lc) { case 0:
+#define PT_END(pstrPT)                 } (pstrPT)->u16Lc=0; return PT_ENDED; }
+
+//return here until cond is true
+#define PT_WAIT_UNTIL(pstrPT,cond)     do{ (pstrPT)->u16Lc=__LINE__; case __LINE__:      \
+                                           if (!(cond)) { return PT_WAITING; } }while(0)
+//give the other threads one turn
+#define PT_YIELD(pstrPT)               do{ u8PTYield=0; (pstrPT)->u16Lc=__LINE__; case __LINE__: \
+                                           if (u8PTYield == 0) { return PT_YIELDED; } }while(0)
+#define PT_EXIT(pstrPT)                do{ (pstrPT)->u16Lc=0; return PT_EXITED; }while(0)
+#define PT_RESTART(pstrPT)             do{ (pstrPT)->u16Lc=0; return PT_WAITING; }while(0)
+//run a child thread to its end
+#define PT_AWAIT_THREAD(pstrPT,thread) PT_WAIT_UNTIL(pstrPT,(thread) >= PT_EXITED)
+//1 while the thread has not ended
+#define PT_SCHEDULE(thread)            ((thread) < PT_EXITED)
+
+//wait u32Ms milliseconds (up to PT_MAX_MS) from now
+#define PT_AWAIT_MS(pstrPT,u32Ms)      do{ (pstrPT)->u32Deadline=STimer_Now()+PT_MS_TO_TICKS(u32Ms); \
+                                           PT_WAIT_UNTIL(pstrPT,PT_Expired(pstrPT)); }while(0)
+//wait until u32Ms after the last time wait ended, a loop of these keeps its period without drift
+#define PT_AWAIT_PERIOD_MS(pstrPT,u32Ms) do{ (pstrPT)->u32Deadline+=PT_MS_TO_TICKS(u32Ms);       \
+                                           PT_WAIT_UNTIL(pstrPT,PT_Expired(pstrPT)); }while(0)
+//wait for cond for up to u32Ms, cond is evaluated once per check and PT_TimedOut tells
+//afterwards which one ended the wait
+#define PT_AWAIT_UNTIL_MS(pstrPT,cond,u32Ms) do{ (pstrPT)->u32Deadline=STimer_Now()+PT_MS_TO_TICKS(u32Ms); \
+                                           PT_WAIT_UNTIL(pstrPT,PT_CondOrExpired((pstrPT),(cond) != 0)); }while(0)
+//wait until the input pin reads u8Level
+#define PT_AWAIT_PIN(pstrPT,enuPin,u8Level)  PT_WAIT_UNTIL(pstrPT,PT_PinIs((enuPin),(u8Level)))
+//wait until the event is signaled and take it
+#define PT_AWAIT_EVENT(pstrPT,u8Event) PT_WAIT_UNTIL(pstrPT,PT_EventTake(u8Event))
+
+/************************************************************************************
+* Parameters (in): strPT_t* pstrPT
+* Parameters (out): uint8_t
+* Return value: 1 if the deadline of the thread has passed, else 0
+* Description: A function to check the time wait of a thread, used by the PT_AWAIT_*MS macros
+************************************************************************************/
+uint8_t PT_Expired(strPT_t* pstrPT);
+
+/************************************************************************************
+* Parameters (in): strPT_t* pstrPT, uint8_t u8Cond
+* Parameters (out): uint8_t
+* Return value: 1 if u8Cond is true or the deadline of the thread has passed, else 0
+* Description: A function to check the wait of PT_AWAIT_UNTIL_MS and record which one ended it,
+*              the condition wins over a deadline that passed at the same check
+************************************************************************************/
+uint8_t PT_CondOrExpired(strPT_t* pstrPT, uint8_t u8Cond);
+
+/************************************************************************************
+* Parameters (in): strPT_t* pstrPT
+* Parameters (out): uint8_t
+* Return value: 1 if the last PT_AWAIT_UNTIL_MS ended on its timeout, else 0
+* Description: A function to tell after PT_AWAIT_UNTIL_MS if the condition or the time ended the wait
+************************************************************************************/
+uint8_t PT_TimedOut(strPT_t* pstrPT);
+
+/************************************************************************************
+* Parameters (in): enuDIOPinNo_t enuPin, uint8_t u8Level
+* Parameters (out): uint8_t
+* Return value: 1 if the pin reads u8Level, else 0 (also for an invalid pin)
+* Description: A function to compare a pin with a level, used by PT_AWAIT_PIN
+************************************************************************************/
+uint8_t PT_PinIs(enuDIOPinNo_t enuPin, uint8_t u8Level);
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Event
+* Parameters (out): enuErrorStatus_t
+* Return value: 1=SUCCESS or 0=FAIL
+* Description: A function to signal event u8Event (0 to PT_EVENTS_NO-1), callable from an ISR,
+*              a signal nobody took yet is not counted twice
+************************************************************************************/
+enuErrorStatus_t PT_EventSignal(uint8_t u8Event);
+
+/************************************************************************************
+* Parameters (in): uint8_t u8Event
+* Parameters (out): uint8_t
+* Return value: 1 if the event was signaled (it is taken), else 0
+* Description: A function to take a signaled event, used by PT_AWAIT_EVENT
+************************************************************************************/
+uint8_t PT_EventTake(uint8_t u8Event);
+
+#endif /* __PT__ */
@@ -0,0 +1,173 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: Ring.h
+* Description: File containing the single producer single consumer ring buffer macros
+* Author: Amr Mohamed
+* Date: 19/10/2026
+******************************************************************************/
+
+#ifndef __RING__
+#define __RING__
+
+#include "DataTypes.h"
+#include "Utils.h"
+#include "Atomic.h"
+
+/*
+ * Lock free rings for one producer and one consumer, typically an ISR and the main loop.
+ * RING_DEFINE(name,type,size) makes the type strname_t and its static inline functions
+ * name_Push, name_Pop... for items of any type, size a power of two up to 128:
+ *
+ *    RING_DEFINE(CaptureRing,uint16_t,16)
+ *    strCaptureRing_t Gstr_CaptureRing;
+ *    ...ISR:        CaptureRing_Push(&Gstr_CaptureRing,ICR1_R);
+ *    ...main loop:  while (CaptureRing_Pop(&Gstr_CaptureRing,&u16Time) == SUCCESS) {...}
+ *
+ * Head and tail are free running 8 bit counters, the array index is the counter masked with
+ * size-1 and the count is head-tail in 8 bits, so all size slots are usable. Only the producer
+ * writes the head and only the consumer the tail, each with one sts, so neither side masks
+ * interrupts. Items are stored before the head moves (ATOMIC_BARRIER keeps the compiler from
+ * reordering them) and read before the tail moves.
+ *
+ * Without copies: name_Slot gives the producer a pointer to its n-th free slot and
+ * name_Commit publishes what it filled, name_Peek gives the consumer a pointer to its n-th item
+ * and name_Drop frees what it used. The block functions move several items with one index
+ * update: name_PushBlock queues all or nothing, name_PopBlock takes what there is.
+ *
+ * Cost for a one byte item, inlined at -Os (instruction count estimate, not measured, no
+ * simulator in this tree): Push ~18 cycles, Pop ~17 cycles, Count 4 cycles, about 3 more
+ * cycles per extra byte of the item. Not inlined add ~8 cycles for the call.
+ * Tools/ring_bench.c tests the macros on a Linux host and compares them with the former UART ring.
+ */
+
+#define RING_DEFINE(name,type,size)                                                          \
+STATIC_ASSERT(((size) & ((size)-1)) == 0 && (size) >= 2 && (size) <= 128,name##_size);       \
+typedef struct                                                                               \
+{                                                                                            \
+   type atItems[size];                                                                       \
+   volatile uint8_t u8Head;           /* producer, items pushed */                           \
+   volatile uint8_t u8Tail;           /* consumer, items popped */                           \
+}str##name##_t;                                                                              \
+                                                                                             \
+/* empty the ring, neither side may be using it */                                           \
+static inline void name##_Init(str##name##_t* pstrRing)                                      \
+{                                                                                            \
+   pstrRing->u8Head=0;                                                                       \
+   pstrRing->u8Tail=0;                                                                       \
+}                                                                                            \
+                                                                                             \
+/* items queued, exact for the consumer, a lower bound for the producer */                   \
+static inline uint8_t name##_Count(const str##name##_t* pstrRing)                            \
+{                                                                                            \
+   return (uint8_t)(pstrRing->u8Head-pstrRing->u8Tail);                                      \
+}                                                                                            \
+                                                                                             \
+/* free slots, exact for the producer, a lower bound for the consumer */                     \
+static inline uint8_t name##_Free(const str##name##_t* pstrRing)                             \
+{                                                                                            \
+   return (uint8_t)((size)-name##_Count(pstrRing));                                          \
+}                                                                                            \
+                                                                                             \
+/* producer: queue one item, ERROR when full */                                              \
+static inline enuErrorStatus_t name##_Push(str##name##_t* pstrRing, type tItem)              \
+{                                                                                            \
+   uint8_t u8Head=pstrRing->u8Head;                                                          \
+   if ((uint8_t)(u8Head-pstrRing->u8Tail) >= (size))                                         \
+   {                                                                                         \
+      return ERROR;                                                                          \
+   }                                                                                         \
+   pstrRing->atItems[u8Head & ((size)-1)]=tItem;                                             \
+   ATOMIC_BARRIER();                                                                         \
+   pstrRing->u8Head=u8Head+1;                                                                \
+   return SUCCESS;                                                                           \
+}                                                                                            \
+                                                                                             \
+/* consumer: take the oldest item, ERROR when empty */                                       \
+static inline enuErrorStatus_t name##_Pop(str##name##_t* pstrRing, type* ptItem)             \
+{                                                                                            \
+   uint8_t u8Tail=pstrRing->u8Tail;                                                          \
+   if (u8Tail == pstrRing->u8Head)                                                           \
+   {                                                                                         \
+      return ERROR;                                                                          \
+   }                                                                                         \
+   *ptItem=pstrRing->atItems[u8Tail & ((size)-1)];                                           \
+   ATOMIC_BARRIER();                                                                         \
+   pstrRing->u8Tail=u8Tail+1;                                                                \
+   return SUCCESS;                                                                           \
+}                                                                                            \
+                                                                                             \
+/* producer: queue u8Count items, all or none (ERROR) */                                     \
+static inline enuErrorStatus_t name##_PushBlock(str##name##_t* pstrRing,                     \
+                                                const type* ptItems, uint8_t u8Count)        \
+{                                                                                            \
+   uint8_t u8Head=pstrRing->u8Head;                                                          \
+   uint8_t u8i;                                                                              \
+   if (u8Count > (uint8_t)((size)-(uint8_t)(u8Head-pstrRing->u8Tail)))                       \
+   {                                                                                         \
+      return ERROR;                                                                          \
+   }                                                                                         \
+   for (u8i=0;u8i<u8Count;u8i++)                                                             \
+   {                                                                                         \
+      pstrRing->atItems[(uint8_t)(u8Head+u8i) & ((size)-1)]=ptItems[u8i];                    \
+   }                                                                                         \
+   ATOMIC_BARRIER();                                                                         \
+   pstrRing->u8Head=u8Head+u8Count;                                                          \
+   return SUCCESS;                                                                           \
+}                                                                                            \
+                                                                                             \
+/* consumer: take up to u8Max items, returns how many */                                     \
+static inline uint8_t name##_PopBlock(str##name##_t* pstrRing, type* ptItems, uint8_t u8Max) \
+{                                                                                            \
+   uint8_t u8Tail=pstrRing->u8Tail;                                                          \
+   uint8_t u8Count=(uint8_t)(pstrRing->u8Head-u8Tail);                                       \
+   uint8_t u8i;                                                                              \
+   if (u8Count > u8Max)                                                                      \
+   {                                                                                         \
+      u8Count=u8Max;                                                                         \
+   }                                                                                         \
+   for (u8i=0;u8i<u8Count;u8i++)                                                             \
+   {                                                                                         \
+      ptItems[u8i]=pstrRing->atItems[(uint8_t)(u8Tail+u8i) & ((size)-1)];                    \
+   }                                                                                         \
+   ATOMIC_BARRIER();                                                                         \
+   pstrRing->u8Tail=u8Tail+u8Count;                                                          \
+   return u8Count;                                                                           \
+}                                                                                            \
+                                                                                             \
+/* producer: the u8Index-th free slot to fill in place, NULLPTR if there is none */          \
+static inline type* name##_Slot(str##name##_t* pstrRing, uint8_t u8Index)                    \
+{                                                                                            \
+   uint8_t u8Head=pstrRing->u8Head;                                                          \
+   if (u8Index >= (uint8_t)((size)-(uint8_t)(u8Head-pstrRing->u8Tail)))                      \
+   {                                                                                         \
+      return NULLPTR;                                                                        \
+   }                                                                                         \
+   return &pstrRing->atItems[(uint8_t)(u8Head+u8Index) & ((size)-1)];                        \
+}                                                                                            \
+                                                                                             \
+/* producer: publish the first u8Count slots filled through name_Slot */                     \
+static inline void name##_Commit(str##name##_t* pstrRing, uint8_t u8Count)                   \
+{                                                                                            \
+   ATOMIC_BARRIER();                                                                         \
+   pstrRing->u8Head=pstrRing->u8Head+u8Count;                                                \
+}                                                                                            \
+                                                                                             \
+/* consumer: the u8Index-th oldest item without taking it, NULLPTR if there is none */       \
+static inline type* name##_Peek(str##name##_t* pstrRing, uint8_t u8Index)                    \
+{                                                                                            \
+   uint8_t u8Tail=pstrRing->u8Tail;                                                          \
+   if (u8Index >= (uint8_t)(pstrRing->u8Head-u8Tail))                                        \
+   {                                                                                         \
+      return NULLPTR;                                                                        \
+   }                                                                                         \
+   return &pstrRing->atItems[(uint8_t)(u8Tail+u8Index) & ((size)-1)];                        \
+}                                                                                            \
+                                                                                             \
+/* consumer: free the u8Count oldest items (up to name_Count) read through name_Peek */      \
+static inline void name##_Drop(str##name##_t* pstrRing, uint8_t u8Count)                     \
+{                                                                                            \
+   ATOMIC_BARRIER();                                                                         \
+   pstrRing->u8Tail=pstrRing->u8Tail+u8Count;                                                \
+}
+
+#endif /* __RING__ */
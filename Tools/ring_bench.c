@@ -0,0 +1,388 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: ring_bench.c
+* Description: Host side test and benchmark of the ring buffer macros (see SERVICE/Ring/Ring.h)
+* Author: Amr Mohamed
+* Date: 19/10/2026
+*
+* Build: gcc -O2 -pthread -I. -IMCAL -ISERVICE/Ring -o ring_bench Tools/ring_bench.c
+* Usage: ./ring_bench [million items]     (default: 20)
+*
+* Compiles Ring.h with the AVR type widths and checks:
+*   - the empty and full states of every function (Push, Pop, blocks, Slot/Commit, Peek/Drop)
+*   - the FIFO order across the 8 bit head/tail wrap with every mix of single, block and in
+*     place accesses
+*   - the head/tail ordering with a producer and a consumer thread moving the items, the
+*     consumer has to see every sequence number once and in order
+* then compares the ring with the former UART ring (one slot kept empty, masked indices):
+* usable slots and RAM per size, host time per push+pop, and the AVR cycle estimates.
+* The host times are relative only, an x86 core says nothing about AVR cycles, and the host
+* thread test relies on x86 keeping stores in order (the AVR is one in-order core).
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+
+//the driver types with their AVR widths, DataTypes.h assumes a 16 bit int
+#define __DATA_TYPES__
+typedef int8_t    sint8_t;
+typedef int16_t   sint16_t;
+typedef int32_t   sint32_t;
+typedef int64_t   sint64_t;
+#define NULLPTR   ((void *) 0)
+typedef enum{
+   ERROR,
+   SUCCESS
+}enuErrorStatus_t;
+
+#include "../SERVICE/Ring/Ring.h"
+
+RING_DEFINE(ByteRing,uint8_t,64)
+RING_DEFINE(SmallRing,uint8_t,8)
+RING_DEFINE(WordRing,uint32_t,128)
+
+//the former UART transmit ring, as it was in UART.c
+#define LEGACY_SIZE     64
+#define LEGACY_MASK     (LEGACY_SIZE-1)
+typedef struct
+{
+   uint8_t au8Buffer[LEGACY_SIZE];
+   volatile uint8_t u8Head;
+   volatile uint8_t u8Tail;
+}strLegacyRing_t;
+
+static int failures=0;
+
+#define CHECK(cond)     do{ if (!(cond)) { failures++; printf("FAIL %s:%d %s\n",__FILE__,__LINE__,#cond); } }while(0)
+
+static int legacy_put(strLegacyRing_t* ring, uint8_t data)
+{
+   uint8_t head=ring->u8Head;
+   if (((uint8_t)(ring->u8Tail-head-1) & LEGACY_MASK) == 0)
+   {
+      return 0;
+   }
+   ring->au8Buffer[head]=data;
+   ring->u8Head=(head+1) & LEGACY_MASK;
+   return 1;
+}
+
+static int legacy_get(strLegacyRing_t* ring, uint8_t* data)
+{
+   uint8_t tail=ring->u8Tail;
+   if (tail == ring->u8Head)
+   {
+      return 0;
+   }
+   *data=ring->au8Buffer[tail];
+   ring->u8Tail=(tail+1) & LEGACY_MASK;
+   return 1;
+}
+
+static void test_empty_full(void)
+{
+   strSmallRing_t ring;
+   uint8_t data=0;
+   uint8_t block[16];
+   uint8_t i;
+
+   SmallRing_Init(&ring);
+   CHECK(SmallRing_Count(&ring) == 0);
+   CHECK(SmallRing_Free(&ring) == 8);
+   CHECK(SmallRing_Pop(&ring,&data) == ERROR);
+   CHECK(SmallRing_PopBlock(&ring,block,16) == 0);
+   CHECK(SmallRing_Peek(&ring,0) == NULLPTR);
+   CHECK(SmallRing_Slot(&ring,7) != NULLPTR);
+   CHECK(SmallRing_Slot(&ring,8) == NULLPTR);
+
+   //every slot is usable, the 9th push fails
+   for (i=0;i<8;i++)
+   {
+      CHECK(SmallRing_Push(&ring,i) == SUCCESS);
+   }
+   CHECK(SmallRing_Push(&ring,8) == ERROR);
+   CHECK(SmallRing_Count(&ring) == 8);
+   CHECK(SmallRing_Free(&ring) == 0);
+   CHECK(SmallRing_PushBlock(&ring,block,1) == ERROR);
+   CHECK(SmallRing_Slot(&ring,0) == NULLPTR);
+   CHECK(SmallRing_Peek(&ring,7) != NULLPTR && *SmallRing_Peek(&ring,7) == 7);
+   CHECK(SmallRing_Peek(&ring,8) == NULLPTR);
+
+   //a block that does not fit is not queued at all
+   SmallRing_Drop(&ring,3);
+   CHECK(SmallRing_PushBlock(&ring,block,4) == ERROR);
+   CHECK(SmallRing_Count(&ring) == 5);
+   CHECK(SmallRing_Pop(&ring,&data) == SUCCESS && data == 3);
+}
+
+static void test_wrap(void)
+{
+   strSmallRing_t ring;
+   uint8_t  next_in=0;
+   uint8_t  next_out=0;
+   uint8_t  block[8];
+   uint8_t  data;
+   uint8_t  count;
+   uint8_t  i;
+   uint8_t* slot;
+   uint32_t step;
+
+   SmallRing_Init(&ring);
+   //enough steps for the head and the tail to wrap their 8 bits many times
+   for (step=0;step<100000;step++)
+   {
+      count=(uint8_t)(step*7 % 9);
+      switch (step % 3)
+      {
+         case 0:
+            for (i=0;i<count;i++)
+            {
+               if (SmallRing_Push(&ring,next_in) == SUCCESS)
+               {
+                  next_in++;
+               }
+            }
+         break;
+         case 1:
+            for (i=0;i<count;i++)
+            {
+               block[i]=(uint8_t)(next_in+i);
+            }
+            if (SmallRing_PushBlock(&ring,block,count) == SUCCESS)
+            {
+               next_in+=count;
+            }
+            else
+            {
+               CHECK(count > SmallRing_Free(&ring));
+            }
+         break;
+         default:
+            for (i=0;(slot=SmallRing_Slot(&ring,i)) != NULLPTR && i<count;i++)
+            {
+               *slot=(uint8_t)(next_in+i);
+            }
+            SmallRing_Commit(&ring,i);
+            next_in+=i;
+         break;
+      }
+      CHECK((uint8_t)(next_in-next_out) == SmallRing_Count(&ring));
+
+      count=(uint8_t)(step*5 % 10);
+      switch (step % 4)
+      {
+         case 0:
+            while (count-- && SmallRing_Pop(&ring,&data) == SUCCESS)
+            {
+               CHECK(data == next_out);
+               next_out++;
+            }
+         break;
+         case 1:
+            count=SmallRing_PopBlock(&ring,block,count);
+            for (i=0;i<count;i++)
+            {
+               CHECK(block[i] == next_out);
+               next_out++;
+            }
+         break;
+         default:
+            for (i=0;i<count && SmallRing_Peek(&ring,i) != NULLPTR;i++)
+            {
+               CHECK(*SmallRing_Peek(&ring,i) == (uint8_t)(next_out+i));
+            }
+            SmallRing_Drop(&ring,i);
+            next_out+=i;
+         break;
+      }
+      CHECK((uint8_t)(next_in-next_out) == SmallRing_Count(&ring));
+   }
+}
+
+static strWordRing_t Gstr_ThreadRing;
+static uint32_t thread_items;
+
+static void* producer(void* arg)
+{
+   uint32_t seq=0;
+   uint32_t block[2];
+   uint32_t* slot;
+   uint32_t last;
+   (void)arg;
+   while (seq < thread_items)
+   {
+      last=seq;
+      //mix the three ways of filling the ring
+      switch (seq & 3)
+      {
+         case 0:
+            if (WordRing_Push(&Gstr_ThreadRing,seq) == SUCCESS)
+            {
+               seq++;
+            }
+         break;
+         case 1:
+            //a block of 2 so the next item goes through a slot
+            block[0]=seq;
+            block[1]=seq+1;
+            if (seq+2 <= thread_items && WordRing_PushBlock(&Gstr_ThreadRing,block,2) == SUCCESS)
+            {
+               seq+=2;
+            }
+            else if (seq+2 > thread_items && WordRing_Push(&Gstr_ThreadRing,seq) == SUCCESS)
+            {
+               seq++;
+            }
+         break;
+         default:
+            slot=WordRing_Slot(&Gstr_ThreadRing,0);
+            if (slot != NULLPTR)
+            {
+               *slot=seq;
+               WordRing_Commit(&Gstr_ThreadRing,1);
+               seq++;
+            }
+         break;
+      }
+      //the ring is full, let the consumer run on a single core host
+      if (seq == last)
+      {
+         sched_yield();
+      }
+   }
+   return NULL;
+}
+
+static void test_threads(uint32_t items)
+{
+   pthread_t thread;
+   uint32_t expect=0;
+   uint32_t block[8];
+   uint32_t* item;
+   uint8_t  count;
+   uint8_t  i;
+   uint32_t errors=0;
+
+   WordRing_Init(&Gstr_ThreadRing);
+   thread_items=items;
+   if (pthread_create(&thread,NULL,producer,NULL) != 0)
+   {
+      failures++;
+      printf("FAIL no producer thread\n");
+      return;
+   }
+   while (expect < items)
+   {
+      if (expect & 1)
+      {
+         count=WordRing_PopBlock(&Gstr_ThreadRing,block,8);
+         if (count == 0)
+         {
+            sched_yield();
+         }
+         for (i=0;i<count;i++)
+         {
+            errors+=(block[i] != expect);
+            expect++;
+         }
+      }
+      else
+      {
+         item=WordRing_Peek(&Gstr_ThreadRing,0);
+         if (item != NULLPTR)
+         {
+            errors+=(*item != expect);
+            WordRing_Drop(&Gstr_ThreadRing,1);
+            expect++;
+         }
+         else
+         {
+            sched_yield();
+         }
+      }
+   }
+   pthread_join(thread,NULL);
+   CHECK(errors == 0);
+   CHECK(WordRing_Count(&Gstr_ThreadRing) == 0);
+   printf("threads: %lu items through a 128 slot ring, %lu out of order\n",(unsigned long)items,(unsigned long)errors);
+}
+
+static double seconds(void)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC,&now);
+   return (double)now.tv_sec+(double)now.tv_nsec*1e-9;
+}
+
+static void bench(uint32_t items)
+{
+   static strByteRing_t ring;
+   static strLegacyRing_t legacy;
+   volatile uint8_t sink=0;
+   uint8_t data=0;
+   uint32_t n;
+   double start;
+   double ring_ns;
+   double legacy_ns;
+
+   //push and pop in bursts of 32 so both stay away from full and empty
+   ByteRing_Init(&ring);
+   start=seconds();
+   for (n=0;n<items;n++)
+   {
+      ByteRing_Push(&ring,(uint8_t)n);
+      if ((n & 31) == 31)
+      {
+         while (ByteRing_Pop(&ring,&data) == SUCCESS)
+         {
+            sink+=data;
+         }
+      }
+   }
+   ring_ns=(seconds()-start)*1e9/items;
+
+   legacy.u8Head=0;
+   legacy.u8Tail=0;
+   start=seconds();
+   for (n=0;n<items;n++)
+   {
+      legacy_put(&legacy,(uint8_t)n);
+      if ((n & 31) == 31)
+      {
+         while (legacy_get(&legacy,&data))
+         {
+            sink+=data;
+         }
+      }
+   }
+   legacy_ns=(seconds()-start)*1e9/items;
+   (void)sink;
+
+   printf("\n%-28s %12s %12s\n","64 byte buffer","Ring.h","former UART");
+   printf("%-28s %12u %12u\n","usable slots",(unsigned)ByteRing_Free(&ring),(unsigned)LEGACY_SIZE-1);
+   printf("%-28s %12u %12u\n","RAM bytes",(unsigned)sizeof(strByteRing_t),(unsigned)sizeof(strLegacyRing_t));
+   printf("%-28s %12.2f %12.2f\n","host ns per push+pop",ring_ns,legacy_ns);
+   //instruction count of the -Os code for one byte item, not measured (no AVR simulator here)
+   printf("%-28s %12s %12s\n","AVR cycles push (estimate)","~18","~20");
+   printf("%-28s %12s %12s\n","AVR cycles pop (estimate)","~17","~17");
+}
+
+int main(int argc, char* argv[])
+{
+   uint32_t millions=(argc > 1) ? (uint32_t)strtoul(argv[1],NULL,0) : 20;
+   if (millions == 0 || millions > 4000)
+   {
+      fprintf(stderr,"bad arguments\n");
+      return 1;
+   }
+   test_empty_full();
+   test_wrap();
+   printf("empty/full and wrap tests: %s\n",failures ? "FAILED" : "passed");
+   test_threads(millions*1000000UL);
+   bench(millions*1000000UL);
+   return failures ? 1 : 0;
+}
@@ -0,0 +1,277 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: timer_solve_bench.c
+* Description: Host side accuracy benchmark of the timer solver (see MCAL/Timer/TimerSolve.h)
+* Author: Amr Mohamed
+* Date: 19/10/2026
+*
+* Build: gcc -O2 -I. -IMCAL -IMCAL/Timer -o timer_solve_bench Tools/timer_solve_bench.c
+* Usage: ./timer_solve_bench [cpu MHz] [max delay us]     (defaults: 8 10000000)
+*
+* Runs the driver's solver, compiled with the AVR type widths, over every delay of the range:
+*   - T0_Start delays (timer 0 overflow mode, 1 us steps), against the former fixed
+*     256/2048/8192 us thresholds with truncated ticks, the achieved periods come from a tick
+*     by tick model of the timer 0 start value and overflow ISR (the current and the former
+*     driver), the first period and a repeated one, not from the solver's own figure
+*   - one compare match per period on each timer (hardware triggers), every cycle count
+*     the timer can reach
+*   - up to 1000 compare matches per period on each timer, 1 us steps up to 1 s
+* and prints the worst and mean error and the mean interrupts per period of each sweep, and
+* the T0_Start periods where the driver model and the solver disagree.
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+//the driver types with their AVR widths, DataTypes.h assumes a 16 bit int
+#define __DATA_TYPES__
+typedef int8_t    sint8_t;
+typedef int16_t   sint16_t;
+typedef int32_t   sint32_t;
+typedef int64_t   sint64_t;
+#define NULLPTR   ((void *) 0)
+typedef enum{
+   ERROR,
+   SUCCESS
+}enuErrorStatus_t;
+
+#include "../MCAL/Timer/TimerSolve.c"
+
+typedef struct
+{
+   const char* name;
+   uint64_t    runs;
+   uint64_t    failures;
+   double      sum_abs_ppm;
+   double      worst_ppm;
+   uint32_t    worst_cycles;
+   double      sum_abs_err_cycles;
+   uint32_t    worst_err_cycles;
+   double      sum_interrupts;
+}strSweep_t;
+
+static void sweep_add(strSweep_t* sweep, uint32_t cycles, uint32_t achieved, double interrupts)
+{
+   uint32_t err=(achieved > cycles) ? achieved-cycles : cycles-achieved;
+   double ppm=(double)err*1e6/(double)cycles;
+   sweep->runs++;
+   sweep->sum_abs_ppm+=ppm;
+   sweep->sum_abs_err_cycles+=err;
+   sweep->sum_interrupts+=interrupts;
+   if (ppm > sweep->worst_ppm)
+   {
+      sweep->worst_ppm=ppm;
+      sweep->worst_cycles=cycles;
+   }
+   if (err > sweep->worst_err_cycles)
+   {
+      sweep->worst_err_cycles=err;
+   }
+}
+
+static void sweep_print(const strSweep_t* sweep, uint32_t mhz)
+{
+   if (sweep->runs == 0)
+   {
+      printf("%-34s no solution (%llu failures)\n",sweep->name,(unsigned long long)sweep->failures);
+      return;
+   }
+   printf("%-34s %10llu %8llu %12.1f %12.1f %10.3f %10.3f %10.2f  (worst at %lu cycles)\n",
+          sweep->name,(unsigned long long)sweep->runs,(unsigned long long)sweep->failures,
+          sweep->sum_abs_ppm/sweep->runs,sweep->worst_ppm,
+          sweep->sum_abs_err_cycles/sweep->runs/mhz,(double)sweep->worst_err_cycles/mhz,
+          sweep->sum_interrupts/sweep->runs,(unsigned long)sweep->worst_cycles);
+}
+
+//timer 0 as T0_Start leaves it and the overflow ISR state, the ISR entry latency is not modelled
+typedef struct
+{
+   uint32_t tcnt;
+   uint32_t current;
+   uint32_t max;
+   uint8_t  last;
+   uint8_t  former;
+}strT0Sim_t;
+
+//T0_Start: former driver max=whole overflows and a start at 0 (at 256-last without overflows),
+//current driver max=overflows per period and a start at 256-last
+static void t0_sim_start(strT0Sim_t* sim, uint32_t count, uint8_t top, uint8_t former)
+{
+   sim->current=0;
+   sim->last=top;
+   sim->former=former;
+   if (former)
+   {
+      sim->max=count;
+      sim->tcnt=(count == 0) ? (uint8_t)(256-top) : 0;
+   }
+   else
+   {
+      sim->max=count+(top != 0);
+      sim->tcnt=(uint8_t)(256-top);
+   }
+}
+
+//ticks from the start or the last callback to the next callback, the overflows that only
+//increment the counter are taken in one step
+static uint32_t t0_sim_period(strT0Sim_t* sim, uint32_t* irqs)
+{
+   uint32_t ticks=0;
+   uint32_t n;
+   *irqs=0;
+   for (;;)
+   {
+      n=sim->former ? ((sim->current < sim->max) ? sim->max-sim->current : 0)
+                    : ((sim->current+1 < sim->max) ? sim->max-1-sim->current : 0);
+      if (n != 0)
+      {
+         ticks+=(256-sim->tcnt)+256*(n-1);
+         sim->tcnt=0;
+         sim->current+=n;
+         *irqs+=n;
+         continue;
+      }
+      //the overflow and the ISR
+      ticks+=256-sim->tcnt;
+      sim->tcnt=0;
+      (*irqs)++;
+      if (sim->former)
+      {
+         //former T0_OVFHandler: one more pass to reload 255-last, then the callback
+         if (sim->current == sim->max)
+         {
+            sim->tcnt=255-sim->last;
+            sim->current++;
+         }
+         else
+         {
+            sim->current=0;
+            return ticks;
+         }
+      }
+      else
+      {
+         //T0_OVFHandler and T0_FastTickHandler: the callback on the last overflow, which
+         //preloads the partial overflow of the next period
+         sim->current=0;
+         if (sim->last != 0)
+         {
+            sim->tcnt=(uint8_t)(256-sim->last);
+         }
+         return ticks;
+      }
+   }
+}
+
+//the first and a repeated period of a T0_Start
+static void t0_sim_add(strSweep_t* sweep, uint32_t cycles, uint32_t count, uint8_t top, uint8_t former,
+                       uint16_t prescaler, uint32_t* periods)
+{
+   strT0Sim_t sim;
+   uint32_t irqs;
+   uint8_t  i;
+   t0_sim_start(&sim,count,top,former);
+   for (i=0;i<2;i++)
+   {
+      periods[i]=t0_sim_period(&sim,&irqs)*prescaler;
+      sweep_add(sweep,cycles,periods[i],irqs);
+   }
+}
+
+//the former T0_Start prescaler choice, thresholds in us for 8 MHz and truncated ticks
+static void legacy_t0_add(strSweep_t* sweep, uint32_t us, uint32_t mhz)
+{
+   uint32_t prescaler;
+   uint32_t ticks;
+   uint32_t periods[2];
+   if      (us <= 256)    prescaler=8;
+   else if (us <= 2048)   prescaler=64;
+   else if (us <= 8192)   prescaler=256;
+   else                   prescaler=1024;
+   ticks=(us*mhz)/prescaler;
+   t0_sim_add(sweep,us*mhz,ticks/256,(uint8_t)ticks,1,(uint16_t)prescaler,periods);
+}
+
+int main(int argc, char* argv[])
+{
+   uint32_t mhz=(argc > 1) ? (uint32_t)strtoul(argv[1],NULL,0) : 8;
+   uint32_t max_us=(argc > 2) ? (uint32_t)strtoul(argv[2],NULL,0) : 10000000UL;
+   uint32_t max_ov;
+   uint32_t us;
+   uint32_t cycles;
+   uint8_t  timer;
+   strTimerSolution_t solution;
+   strSweep_t legacy={.name="T0_Start former driver"};
+   strSweep_t t0_start={.name="T0_Start solver and driver"};
+   strSweep_t single[3]={{.name="CTC 1 match timer 0"},{.name="CTC 1 match timer 1"},{.name="CTC 1 match timer 2"}};
+   strSweep_t multi[3]={{.name="CTC <=1000 matches timer 0"},{.name="CTC <=1000 matches timer 1"},{.name="CTC <=1000 matches timer 2"}};
+   const uint32_t single_max[3]={256UL*1024UL,65536UL*1024UL,256UL*1024UL};
+   uint32_t periods[2];
+   uint32_t mismatches=0;
+
+   if (mhz == 0 || max_us == 0 || (uint64_t)max_us*mhz > 0xFFFFFFFFULL)
+   {
+      fprintf(stderr,"bad arguments\n");
+      return 1;
+   }
+   //same bound as T0_MAX_OVCOUNT in Timer.h
+   max_ov=(max_us*mhz)/(1024UL*256UL)+1;
+   printf("F_CPU %lu MHz, T0_Start up to %lu us (%lu overflows)\n\n",(unsigned long)mhz,(unsigned long)max_us,(unsigned long)max_ov);
+   printf("%-34s %10s %8s %12s %12s %10s %10s %10s\n","sweep","periods","failed","mean |ppm|","worst ppm","mean us","worst us","mean irqs");
+
+   for (us=1;us<=max_us;us++)
+   {
+      cycles=us*mhz;
+      legacy_t0_add(&legacy,us,mhz);
+      if (TimerSolve(TIMERSOLVE_TIMER0,TIMERSOLVE_OVERFLOW,cycles,mhz,max_ov,&solution) == SUCCESS)
+      {
+         t0_sim_add(&t0_start,cycles,solution.u32Count,(uint8_t)solution.u16Top,0,solution.u16Prescaler,periods);
+         if (periods[0] != solution.u32Cycles || periods[1] != solution.u32Cycles)
+         {
+            mismatches++;
+         }
+      }
+      else
+      {
+         t0_start.failures++;
+      }
+   }
+   sweep_print(&legacy,mhz);
+   sweep_print(&t0_start,mhz);
+   printf("T0_Start periods off the solver's figure: %lu\n",(unsigned long)mismatches);
+
+   for (timer=0;timer<3;timer++)
+   {
+      for (cycles=1;cycles<=single_max[timer];cycles++)
+      {
+         if (TimerSolve((enuTimerSolveTimer_t)timer,TIMERSOLVE_CTC,cycles,1,1,&solution) == SUCCESS)
+         {
+            sweep_add(&single[timer],cycles,solution.u32Cycles,1);
+         }
+         else
+         {
+            single[timer].failures++;
+         }
+      }
+      sweep_print(&single[timer],mhz);
+   }
+
+   for (timer=0;timer<3;timer++)
+   {
+      for (us=1;us<=1000000UL;us++)
+      {
+         cycles=us*mhz;
+         if (TimerSolve((enuTimerSolveTimer_t)timer,TIMERSOLVE_CTC,cycles,mhz,1000,&solution) == SUCCESS)
+         {
+            sweep_add(&multi[timer],cycles,solution.u32Cycles,(double)solution.u32Count);
+         }
+         else
+         {
+            multi[timer].failures++;
+         }
+      }
+      sweep_print(&multi[timer],mhz);
+   }
+   return 0;
+}
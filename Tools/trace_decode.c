@@ -0,0 +1,324 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: trace_decode.c
+* Description: Host side decoder for the binary event trace (see MCAL/Trace/Trace.h)
+* Author: Amr Mohamed
+* Date: 19/10/2026
+*
+* Build: gcc -O2 -o trace_decode Tools/trace_decode.c
+* Usage: stty -F /dev/ttyUSB0 38400 raw -echo && ./trace_decode < /dev/ttyUSB0 > trace.json
+*        ./trace_decode capture.bin > trace.json      (open in chrome://tracing or Perfetto)
+*        ./trace_decode -t capture.bin                (text timeline)
+*
+* Reads the UART frame stream, every Trace_DumpStart/Trace_DumpPoll dump becomes one process
+* of the Chrome trace: interrupts as duration slices, timer starts, stops and callbacks as
+* instant events, DIO toggles as a 0/1 counter per pin. Time stamps are micro seconds of the
+* software timer time base. Frames of other types are ignored.
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#define FRAME_SYNC1         0xA5
+#define FRAME_SYNC2         0x5A
+#define FRAME_TRACE_INFO    0x12
+#define FRAME_TRACE_DATA    0x13
+
+#define EV_ISR_ENTER        1
+#define EV_ISR_EXIT         2
+#define EV_TIMER_START      3
+#define EV_TIMER_STOP       4
+#define EV_CALLBACK         5
+#define EV_DIO_TOGGLE       6
+#define EV_USER             0x10
+#define TIMER0_ARG          0xFF
+
+#define MAX_RECORDS         256
+
+typedef enum
+{
+   WAIT_SYNC1,
+   WAIT_SYNC2,
+   WAIT_TYPE,
+   WAIT_LENGTH,
+   WAIT_PAYLOAD,
+   WAIT_CKA,
+   WAIT_CKB
+}enuState_t;
+
+typedef struct
+{
+   uint8_t  event;
+   uint8_t  arg;
+   uint32_t delta;
+}strRecord_t;
+
+static const char* const vector_names[]=
+{
+   "?", "INT0", "INT1", "INT2", "TIMER2_COMP", "TIMER2_OVF", "TIMER1_ICU", "TIMER1_OCA",
+   "TIMER1_OCB", "TIMER1_OVF", "TIMER0_OC", "TIMER0_OVF", "SPI_STC", "UART_RX", "UART_UDRE",
+   "UART_TX", "ADC", "EE_RDY", "ANA_COMP", "TWI", "SPM_RDY"
+};
+
+//current dump
+static uint8_t  ticks_per_us=1;
+static uint16_t dump_length=0;
+static uint16_t dump_lost=0;
+static uint32_t dump_last=0;
+static uint8_t  dump_data[256];
+static uint16_t dump_have=0;
+static int      dump_open=0;
+static unsigned dump_no=0;
+
+static int text_mode=0;
+static int json_first=1;
+
+static const char* vector_name(uint8_t arg)
+{
+   return arg < sizeof(vector_names)/sizeof(vector_names[0]) ? vector_names[arg] : "?";
+}
+
+static void timer_name(uint8_t arg, char* name, size_t size)
+{
+   if (arg == TIMER0_ARG)
+   {
+      snprintf(name,size,"T0");
+   }
+   else
+   {
+      snprintf(name,size,"stimer@..%02X",arg);
+   }
+}
+
+static void pin_name(uint8_t arg, char* name, size_t size)
+{
+   if (arg < 32)
+   {
+      snprintf(name,size,"P%c%u",'A'+arg/8,arg%8);
+   }
+   else
+   {
+      snprintf(name,size,"pin%u",arg);
+   }
+}
+
+static void json_event(const char* name, const char* phase, unsigned tid, double ts, const char* extra)
+{
+   printf("%s\n{\"name\":\"%s\",\"ph\":\"%s\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f%s}",
+          json_first ? "" : ",", name, phase, dump_no, tid, ts, extra);
+   json_first=0;
+}
+
+static void emit(const strRecord_t* record, double ts, uint8_t* pin_levels)
+{
+   char name[32];
+   char extra[48];
+   switch (record->event)
+   {
+      case EV_ISR_ENTER:
+      case EV_ISR_EXIT:
+         if (text_mode) printf("%14.3f  isr %-5s %s\n",ts,record->event==EV_ISR_ENTER ? "enter" : "exit",vector_name(record->arg));
+         else json_event(vector_name(record->arg),record->event==EV_ISR_ENTER ? "B" : "E",1,ts,"");
+      break;
+      case EV_TIMER_START:
+      case EV_TIMER_STOP:
+      case EV_CALLBACK:
+         timer_name(record->arg,name,sizeof(name));
+         if (text_mode)
+         {
+            printf("%14.3f  %-9s %s\n",ts,record->event==EV_TIMER_START ? "start" : record->event==EV_TIMER_STOP ? "stop" : "callback",name);
+         }
+         else
+         {
+            char label[48];
+            snprintf(label,sizeof(label),"%s %s",record->event==EV_TIMER_START ? "start" : record->event==EV_TIMER_STOP ? "stop" : "callback",name);
+            json_event(label,"i",record->event==EV_CALLBACK ? 3 : 2,ts,",\"s\":\"t\"");
+         }
+      break;
+      case EV_DIO_TOGGLE:
+         pin_name(record->arg,name,sizeof(name));
+         pin_levels[record->arg]^=1;
+         if (text_mode)
+         {
+            printf("%14.3f  toggle    %s -> %u\n",ts,name,pin_levels[record->arg]);
+         }
+         else
+         {
+            snprintf(extra,sizeof(extra),",\"args\":{\"level\":%u}",pin_levels[record->arg]);
+            json_event(name,"C",0,ts,extra);
+         }
+      break;
+      default:
+         if (text_mode)
+         {
+            printf("%14.3f  event     0x%02X arg 0x%02X\n",ts,record->event,record->arg);
+         }
+         else
+         {
+            snprintf(name,sizeof(name),"%s 0x%02X",record->event >= EV_USER ? "user" : "event",record->event);
+            snprintf(extra,sizeof(extra),",\"s\":\"t\",\"args\":{\"arg\":%u}",record->arg);
+            json_event(name,"i",4,ts,extra);
+         }
+      break;
+   }
+}
+
+static void decode_dump(void)
+{
+   strRecord_t records[MAX_RECORDS];
+   uint8_t  pin_levels[256];
+   unsigned count=0,i,shift;
+   uint16_t pos=0;
+   uint32_t after=0;
+   double   ts;
+
+   //split the bytes into records
+   while (pos+3 <= dump_length && count < MAX_RECORDS)
+   {
+      records[count].event=dump_data[pos++];
+      records[count].arg=dump_data[pos++];
+      records[count].delta=0;
+      shift=0;
+      while (pos < dump_length && (dump_data[pos] & 0x80) && shift < 28)
+      {
+         records[count].delta|=(uint32_t)(dump_data[pos++] & 0x7F)<<shift;
+         shift+=7;
+      }
+      if (pos >= dump_length)
+      {
+         fprintf(stderr,"dump %u: truncated record\n",dump_no);
+         break;
+      }
+      records[count].delta|=(uint32_t)dump_data[pos++]<<shift;
+      count++;
+   }
+   //the last record is at dump_last, go back from it
+   for (i=count;i>1;i--)
+   {
+      after+=records[i-1].delta;
+   }
+   memset(pin_levels,0,sizeof(pin_levels));
+   if (text_mode)
+   {
+      printf("dump %u: %u records, %u lost, %u ticks/us\n",dump_no,count,dump_lost,ticks_per_us);
+   }
+   for (i=0;i<count;i++)
+   {
+      if (i > 0)
+      {
+         after-=records[i].delta;
+      }
+      ts=(double)(uint32_t)(dump_last-after)/ticks_per_us;
+      emit(&records[i],ts,pin_levels);
+   }
+   fprintf(stderr,"dump %u: %u records, %u lost\n",dump_no,count,dump_lost);
+   dump_no++;
+}
+
+static void handle_frame(uint8_t type, const uint8_t* payload, uint8_t length)
+{
+   if (type == FRAME_TRACE_INFO && length >= 9)
+   {
+      ticks_per_us=payload[0] ? payload[0] : 1;
+      dump_length=(uint16_t)(payload[1] | (payload[2]<<8));
+      dump_lost=(uint16_t)(payload[3] | (payload[4]<<8));
+      dump_last=(uint32_t)payload[5] | ((uint32_t)payload[6]<<8) | ((uint32_t)payload[7]<<16) | ((uint32_t)payload[8]<<24);
+      if (dump_length > sizeof(dump_data))
+      {
+         dump_length=sizeof(dump_data);
+      }
+      dump_have=0;
+      dump_open=1;
+      if (dump_length == 0)
+      {
+         decode_dump();
+         dump_open=0;
+      }
+   }
+   else if (type == FRAME_TRACE_DATA && dump_open)
+   {
+      if (dump_have+length > dump_length)
+      {
+         length=(uint8_t)(dump_length-dump_have);
+      }
+      memcpy(dump_data+dump_have,payload,length);
+      dump_have+=length;
+      if (dump_have == dump_length)
+      {
+         decode_dump();
+         dump_open=0;
+      }
+   }
+}
+
+int main(int argc, char** argv)
+{
+   FILE* in=stdin;
+   enuState_t state=WAIT_SYNC1;
+   uint8_t type=0,length=0,ck_a=0,ck_b=0,count=0;
+   uint8_t payload[256];
+   unsigned long bad=0;
+   int arg=1;
+   int c;
+
+   if (arg < argc && strcmp(argv[arg],"-t") == 0)
+   {
+      text_mode=1;
+      arg++;
+   }
+   if (arg < argc && (in=fopen(argv[arg],"rb")) == NULL)
+   {
+      perror(argv[arg]);
+      return 1;
+   }
+   if (!text_mode)
+   {
+      printf("{\"traceEvents\":[");
+   }
+   while ((c=fgetc(in)) != EOF)
+   {
+      uint8_t b=(uint8_t)c;
+      switch (state)
+      {
+         case WAIT_SYNC1:
+            if (b == FRAME_SYNC1) state=WAIT_SYNC2;
+         break;
+         case WAIT_SYNC2:
+            if (b == FRAME_SYNC2) state=WAIT_TYPE;
+            else if (b != FRAME_SYNC1) state=WAIT_SYNC1;
+         break;
+         case WAIT_TYPE:
+            type=b; ck_a=b; ck_b=ck_a;
+            state=WAIT_LENGTH;
+         break;
+         case WAIT_LENGTH:
+            length=b; ck_a+=b; ck_b+=ck_a; count=0;
+            state=length ? WAIT_PAYLOAD : WAIT_CKA;
+         break;
+         case WAIT_PAYLOAD:
+            payload[count++]=b; ck_a+=b; ck_b+=ck_a;
+            if (count == length) state=WAIT_CKA;
+         break;
+         case WAIT_CKA:
+            if (b == ck_a) state=WAIT_CKB;
+            else { bad++; state=WAIT_SYNC1; }
+         break;
+         case WAIT_CKB:
+            if (b == ck_b) handle_frame(type,payload,length);
+            else bad++;
+            state=WAIT_SYNC1;
+         break;
+      }
+   }
+   if (!text_mode)
+   {
+      printf("\n]}\n");
+   }
+   if (dump_open)
+   {
+      fprintf(stderr,"dump %u: incomplete, %u of %u bytes\n",dump_no,dump_have,dump_length);
+   }
+   fprintf(stderr,"dumps=%u bad_checksum=%lu\n",dump_no,bad);
+   return 0;
+}
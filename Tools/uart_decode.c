@@ -0,0 +1,123 @@
+/*****************************************************************************
+* Task: TIMER_DRIVER
+* File Name: uart_decode.c
+* Description: Host side decoder for the UART framed mode (see MCAL/UART/UART.h)
+* Author: Amr Mohamed
+* Date: 19/10/2026
+*
+* Build: gcc -O2 -o uart_decode Tools/uart_decode.c
+* Usage: stty -F /dev/ttyUSB0 38400 raw -echo && ./uart_decode < /dev/ttyUSB0
+*        ./uart_decode capture.bin
+*
+* Prints one line per valid frame: type, length and the payload in hex, payloads of the
+* driver frame types are also printed as little endian 16/32 bit words. Bytes that are not
+* part of a valid frame are skipped and counted, the decoder resynchronizes on the next
+* sync pair.
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define FRAME_SYNC1         0xA5
+#define FRAME_SYNC2         0x5A
+#define FRAME_TEXT          0x01
+#define FRAME_TIMER_STATS   0x10
+#define FRAME_CAPTURE       0x11
+
+typedef enum
+{
+   WAIT_SYNC1,
+   WAIT_SYNC2,
+   WAIT_TYPE,
+   WAIT_LENGTH,
+   WAIT_PAYLOAD,
+   WAIT_CKA,
+   WAIT_CKB
+}enuState_t;
+
+static void print_frame(unsigned long frame_no, uint8_t type, const uint8_t* payload, uint8_t length)
+{
+   unsigned i;
+   printf("%lu type=0x%02X len=%u", frame_no, type, length);
+   if (type == FRAME_TEXT)
+   {
+      printf(" text=\"%.*s\"", length, (const char*)payload);
+   }
+   else
+   {
+      printf(" data=");
+      for (i=0;i<length;i++)
+      {
+         printf("%02X", payload[i]);
+      }
+      if (type == FRAME_TIMER_STATS || type == FRAME_CAPTURE)
+      {
+         printf(" u32=");
+         for (i=0;i+4<=length;i+=4)
+         {
+            printf("%s%lu", i ? "," : "", (unsigned long)((uint32_t)payload[i] | ((uint32_t)payload[i+1]<<8)
+                   | ((uint32_t)payload[i+2]<<16) | ((uint32_t)payload[i+3]<<24)));
+         }
+         if (length % 4 == 2)
+         {
+            printf("%su16=%u", length>2 ? " " : "", payload[length-2] | (payload[length-1]<<8));
+         }
+      }
+   }
+   printf("\n");
+}
+
+int main(int argc, char** argv)
+{
+   FILE* in=stdin;
+   enuState_t state=WAIT_SYNC1;
+   uint8_t type=0,length=0,ck_a=0,ck_b=0,count=0;
+   uint8_t payload[256];
+   unsigned long frames=0,bad=0,skipped=0;
+   int c;
+
+   if (argc > 1 && (in=fopen(argv[1],"rb")) == NULL)
+   {
+      perror(argv[1]);
+      return 1;
+   }
+   while ((c=fgetc(in)) != EOF)
+   {
+      uint8_t b=(uint8_t)c;
+      switch (state)
+      {
+         case WAIT_SYNC1:
+            if (b == FRAME_SYNC1) state=WAIT_SYNC2; else skipped++;
+         break;
+         case WAIT_SYNC2:
+            if (b == FRAME_SYNC2) state=WAIT_TYPE;
+            else if (b != FRAME_SYNC1) { skipped+=2; state=WAIT_SYNC1; }
+            else skipped++;
+         break;
+         case WAIT_TYPE:
+            type=b; ck_a=b; ck_b=ck_a;
+            state=WAIT_LENGTH;
+         break;
+         case WAIT_LENGTH:
+            length=b; ck_a+=b; ck_b+=ck_a; count=0;
+            state=length ? WAIT_PAYLOAD : WAIT_CKA;
+         break;
+         case WAIT_PAYLOAD:
+            payload[count++]=b; ck_a+=b; ck_b+=ck_a;
+            if (count == length) state=WAIT_CKA;
+         break;
+         case WAIT_CKA:
+            if (b == ck_a) state=WAIT_CKB;
+            else { bad++; state=WAIT_SYNC1; }
+         break;
+         case WAIT_CKB:
+            if (b == ck_b) print_frame(frames++,type,payload,length);
+            else bad++;
+            state=WAIT_SYNC1;
+         break;
+      }
+      fflush(stdout);
+   }
+   fprintf(stderr,"frames=%lu bad_checksum=%lu skipped_bytes=%lu\n",frames,bad,skipped);
+   return 0;
+}
@@ -15,5 +15,8 @@
 #define CLR_BIT(reg,bit)	(reg &= ~(1<<bit))
 #define TOG_BIT(reg,bit)    (reg^= (1<<bit))
 
+//compile time check, fails the build with a negative array size when cond is false
+#define STATIC_ASSERT(cond,name)    typedef char static_assert_##name[(cond) ? 1 : -1]
+
 
 #endif /* __UTILS__ */
\ No newline at end of file
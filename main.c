@@ -10,6 +10,7 @@
 #include "Register.h"
 #include "DIO.h"
 #include "Timer.h"
+#include "STimer.h"
 
 #define  Button1     PA0
 #define  Button2     PB2
@@ -18,6 +19,8 @@
 
 #define BTN1_PRESSED 0
 #define BTN2_PRESSED 1
+//longest a button may stay pressed before the loop goes on without it
+#define BTN_RELEASE_TIMEOUT_US   5000000UL
 
 
 //Testing Application
@@ -41,6 +44,8 @@ int main(void)
    DIO_Write(LED2,1);
    //initialize timer 0
    T0_Init(TIMER0_NORMAL_MODE,TIMER0_SCALER_8);
+   //time base of the button waits
+   STimer_Init();
    //enable global interrupts
    sei();
    while(1)
@@ -56,22 +61,16 @@ int main(void)
          T0_OV_InterruptEnable();
          //set up the delay function using timer
          T0_Start(1000000,led_Toggle);
-         //loop on the button until it is released
-         while (u8button1_flag==BTN1_PRESSED)
-         {
-            DIO_Read(Button1,&u8button1_flag);
-         }
+         //wait for the button to be released, a stuck button does not hang the loop
+         DIO_WaitLevel(Button1,!BTN1_PRESSED,DIO_WAIT_SPIN,BTN_RELEASE_TIMEOUT_US,NULLPTR);
       }
       //if button 2 is pressed
       if (u8button2_flag==BTN2_PRESSED)
       {
          //stop the timer set up on the button
          T0_Stop();
-         //loop on the button until it is released
-         while (u8button2_flag==BTN2_PRESSED)
-         {
-            DIO_Read(Button2,&u8button2_flag);
-         }
+         //wait for the button to be released, a stuck button does not hang the loop
+         DIO_WaitLevel(Button2,!BTN2_PRESSED,DIO_WAIT_SPIN,BTN_RELEASE_TIMEOUT_US,NULLPTR);
       }      
    }   
 }